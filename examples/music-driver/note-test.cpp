@@ -6,7 +6,7 @@
 #include <iostream>
 
 Note note(NoteName::C, 0); 
-ToneDriverSDL2 toneDriver;
+ToneDriverSDL2 toneDriver(AudioInitMode::Background); // Keep device start-up off the critical path before main
 
 const int NOTE_DURATION_MS = 250;
 const int REST_DURATION_MS = 100;
@@ -0,0 +1,75 @@
+/// @file static-dispatch.cpp
+/// @brief Plays the same scales through a StaticToneDriver backend directly and through the virtual ToneDriver interface, and compares the cost of each call.
+///
+/// The backend renders to a virtual clock rather than a speaker, so the timing is all dispatch
+/// and sequencing overhead. Usage: static-dispatch [runs]
+
+#include "music-driver/MusicDriver.h"
+#include "tone-driver/StaticToneDriver.h"
+#include "tone-driver/VirtualToneDriver.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <type_traits>
+
+const int DEFAULT_RUNS = 200000;
+
+
+// A backend like an ATtiny timer: a tone register and a delay, with time simulated
+class ToneTimeline : public StaticToneDriver<ToneTimeline>
+{
+public:
+    void startTone(float freq) { toneFreq = freq; ++toneCount; }
+    void stopTone() { toneFreq = 0.0f; }
+    void waitMs(int durationMs) { clockMs += durationMs; toneMs += (toneFreq > 0.0f) ? durationMs : 0; }
+
+    long long clockMs = 0;      // Simulated time elapsed
+    long long toneMs = 0;       // Simulated time a tone was sounding
+    long long toneCount = 0;    // Tones started
+    float toneFreq = 0.0f;      // Current tone (0 when silent)
+};
+
+static_assert(!std::is_polymorphic<ToneTimeline>::value, "A StaticToneDriver backend has no vtable");
+
+
+// Nanoseconds per note when playing a C major scale up and down runs times
+template <typename Driver>
+double timeScales(Driver& driver, int runs)
+{
+    Key key(NoteName::C, ScaleType::Major);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i)
+    {
+        playScale(driver, key, 4, 1, 100, 20);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    return elapsed.count() / (runs * 15.0); // 15 notes per run
+}
+
+
+int main(int argc, char* argv[])
+{
+    int runs = (argc > 1) ? std::atoi(argv[1]) : DEFAULT_RUNS;
+    if (runs < 1) return 1;
+
+    ToneTimeline staticBackend;
+    double staticNs = timeScales(staticBackend, runs);
+
+    // Through the ToneDriver interface; volatile stops the compiler seeing which driver it is
+    ToneTimeline virtualBackend;
+    VirtualToneDriver<ToneTimeline> wrapped(virtualBackend);
+    ToneDriver* volatile selected = &wrapped;
+    double virtualNs = timeScales(*selected, runs);
+
+    bool same = staticBackend.clockMs == virtualBackend.clockMs && staticBackend.toneMs == virtualBackend.toneMs &&
+                staticBackend.toneCount == virtualBackend.toneCount;
+
+    std::cout << "Played " << staticBackend.toneCount << " notes (" << staticBackend.clockMs / 1000 << " s of simulated time)\n"
+              << "  static dispatch  " << staticNs << " ns per note\n"
+              << "  virtual dispatch " << virtualNs << " ns per note\n"
+              << "  timelines        " << (same ? "identical" : "DIFFERENT") << std::endl;
+
+    return same ? 0 : 1;
+}
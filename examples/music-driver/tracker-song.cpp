@@ -0,0 +1,66 @@
+/// @file tracker-song.cpp
+/// @brief Plays a tracker-style song of reused, transposed patterns via ToneDriverSDL2 and reports how much memory the patterns save.
+///
+/// Usage: tracker-song [--report] (report only, without playing)
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include "music-driver/MusicDriver.h"
+#include <cstring>
+#include <iostream>
+
+const int ROW_MS = 110;
+
+// Every note of the song, stored once
+constexpr TrackerStep STEPS[] = {
+    // 0: Riff
+    trackerNote(NoteName::A, 3, 2), trackerNote(NoteName::E, 4, 1), trackerNote(NoteName::A, 4, 1),
+    trackerNote(NoteName::C, 5, 2), trackerNote(NoteName::B, 4, 1), trackerNote(NoteName::A, 4, 1),
+    trackerNote(NoteName::E, 4, 1), trackerRest(1),
+    // 8: Answer
+    trackerNote(NoteName::F, 4, 1), trackerNote(NoteName::G, 4, 1), trackerNote(NoteName::A, 4, 2),
+    trackerNote(NoteName::G, 4, 1), trackerNote(NoteName::E, 4, 1), trackerNote(NoteName::D, 4, 2),
+    // 14: Ending
+    trackerNote(NoteName::E, 4, 2), trackerNote(NoteName::GSharp, 4, 2), trackerNote(NoteName::A, 4, 6), trackerRest(2)
+};
+
+constexpr TrackerPattern PATTERNS[] = {
+    {0, 8},     // Riff
+    {8, 6},     // Answer
+    {14, 4}     // Ending
+};
+
+// Pattern, transpose, repeat
+constexpr TrackerOrder ORDERS[] = {
+    {0, 0, 4}, {0, 5, 2}, {0, 0, 2},
+    {1, 0, 2}, {1, -2, 2},
+    {0, 7, 2}, {0, 5, 2}, {0, 0, 4},
+    {1, 0, 2}, {2, 0, 1}
+};
+
+TrackerSong song(STEPS, sizeof(STEPS) / sizeof(STEPS[0]), PATTERNS, sizeof(PATTERNS) / sizeof(PATTERNS[0]),
+                 ORDERS, sizeof(ORDERS) / sizeof(ORDERS[0]), ROW_MS);
+
+
+int main(int argc, char* argv[])
+{
+    if (!song.isValid())
+    {
+        std::cerr << "Song refers to a missing pattern or step" << std::endl;
+        return 1;
+    }
+
+    TrackerMemoryReport report = song.getMemoryReport();
+    std::cout << "Tracker song: " << report.flatEvents << " events, " << song.getDurationMs() / 1000.0 << " s\n"
+              << "  patterns and orders: " << report.patternBytes << " bytes\n"
+              << "  flat event list:     " << report.flatBytes << " bytes\n"
+              << "  compression:         " << report.compressionRatio << "x" << std::endl;
+
+    if (argc > 1 && std::strcmp(argv[1], "--report") == 0)
+    {
+        return 0;
+    }
+
+    ToneDriverSDL2 toneDriver;
+    toneDriver.setAmplitude(0.5);
+    playTrackerSong(toneDriver, song);
+}
@@ -0,0 +1,41 @@
+/// @file pcm-stream.cpp
+/// @brief Streams a short tune as raw PCM to stdout via ToneDriverPCM.
+///
+/// Pipe it into a player or encoder, for example:
+///     ./pcm-stream | aplay -f S16_LE -r 44100 -c 1
+///     ./pcm-stream | ffmpeg -f s16le -ar 44100 -ac 1 -i pipe:0 tune.wav
+/// Pass `--realtime` to produce samples at playback speed instead of as fast as possible.
+
+#include "tone-driver-pcm/ToneDriverPCM.h"
+#include <cstring>
+#include <iostream>
+
+const int NOTE_DURATION_MS = 150;
+const int REST_DURATION_MS = 50;
+
+int main(int argc, char* argv[])
+{
+    PcmStreamConfig config;
+    config.pacing = (argc > 1 && std::strcmp(argv[1], "--realtime") == 0) ? PcmPacing::RealTime : PcmPacing::Unpaced;
+
+    // Initialise PCM driver object writing to stdout
+    ToneDriverPCM toneDriver(1, config);
+
+    toneDriver.setAmplitude(0.5);
+
+    const NoteName notes[] = {NoteName::C, NoteName::D, NoteName::E, NoteName::F, NoteName::G, NoteName::A, NoteName::B, NoteName::C};
+    const int octaves[] = {4, 4, 4, 4, 4, 4, 4, 5};
+    toneDriver.playSequence(notes, octaves, 8, NOTE_DURATION_MS, REST_DURATION_MS);
+
+    const NoteName chord[] = {NoteName::C, NoteName::E, NoteName::G};
+    const int chordOctaves[] = {4, 4, 4};
+    toneDriver.playChord(chord, chordOctaves, 3, 600);
+
+    toneDriver.flush();
+
+    // Status goes to stderr so it does not mix with the samples
+    std::cerr << toneDriver.getFramesWritten() << " frames written, " << toneDriver.getBlockedMs() << " ms waiting for the consumer"
+              << (toneDriver.hasWriteError() ? " (write failed)" : "") << std::endl;
+
+    return toneDriver.hasWriteError() ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+/// @file record-replay.cpp
+/// @brief Records a session of ToneDriver calls to a log and replays it, live or rendered offline as fast as possible.
+///
+/// Usage:
+///   record-replay record session.tdl           Play a session on ToneDriverSDL2 and log every call
+///   record-replay replay session.tdl           Replay the log in real time on ToneDriverSDL2
+///   record-replay render session.tdl out.raw   Replay the log unpaced into ToneDriverPCM (s16le, 44100 Hz, mono)
+
+#include "tone-driver-record/ToneDriverRecorder.h"
+#include "tone-driver-record/ToneDriverReplayer.h"
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include "tone-driver-pcm/ToneDriverPCM.h"
+#include "music-driver/MusicDriver.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#define open _open
+#define close _close
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+// Something like a few seconds of a game: a jingle, some effects at odd moments, a held tone
+void playSession(ToneDriver& driver)
+{
+    Key key(NoteName::C, ScaleType::Major);
+    playScale(driver, key, 4, 1, 80, 20);
+
+    const NoteName chord[] = {NoteName::C, NoteName::E, NoteName::G};
+    const int octaves[] = {4, 4, 4};
+    driver.playChord(chord, octaves, 3, 400);
+    driver.rest(150);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        driver.playFrequency(600.0f + 150.0f * i, 40);
+        SDL_Delay(30 + 17 * i); // Game frames between effects
+    }
+
+    driver.playNote(NoteName::A, 4);
+    driver.stopAfter(500);
+}
+
+void printReport(const ReplayReport& report)
+{
+    std::cout << (report.ok ? "Replayed " : "Log corrupt after ") << report.calls << " calls\n";
+    for (int call = 1; call < 16; ++call)
+    {
+        if (report.callCounts[call] > 0)
+        {
+            std::cout << "  " << toneDriverCallToString(ToneDriverCall(call)) << ": " << report.callCounts[call] << "\n";
+        }
+    }
+    std::cout << "Recorded " << report.recordedMs << " ms, replayed in " << report.replayMs << " ms\n"
+              << "Latest call " << report.maxLateMs << " ms behind, slowest call #" << report.slowestCall
+              << " took " << report.maxCallMs << " ms" << std::endl;
+}
+
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: record-replay record|replay|render <log> [out.raw]" << std::endl;
+        return 1;
+    }
+
+    const char* mode = argv[1];
+
+    if (std::strcmp(mode, "record") == 0)
+    {
+        std::ofstream log(argv[2], std::ios::binary);
+        ToneDriverSDL2 toneDriver;
+        ToneDriverRecorder recorder(toneDriver, log);
+
+        playSession(recorder);
+        recorder.flush();
+
+        std::cout << "Recorded " << recorder.getCallCount() << " calls in " << recorder.getLogBytes() << " bytes" << std::endl;
+        return log ? 0 : 1;
+    }
+
+    std::ifstream log(argv[2], std::ios::binary);
+    ToneDriverReplayer replayer(log);
+    if (!replayer.isValid())
+    {
+        std::cerr << argv[2] << " is not a ToneDriver log" << std::endl;
+        return 1;
+    }
+
+    ReplayReport report;
+
+    if (std::strcmp(mode, "replay") == 0)
+    {
+        ToneDriverSDL2 toneDriver;
+        report = replayer.replay(toneDriver, ReplayPacing::RealTime);
+    }
+    else if (std::strcmp(mode, "render") == 0 && argc > 3)
+    {
+        int fd = open(argv[3], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            std::perror(argv[3]);
+            return 1;
+        }
+
+        {
+            ToneDriverPCM pcm(fd);
+            report = replayer.replay(pcm, ReplayPacing::Unpaced);
+        }
+        close(fd);
+    }
+    else
+    {
+        std::cerr << "Unknown mode " << mode << std::endl;
+        return 1;
+    }
+
+    printReport(report);
+    return report.ok ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+/// @file audio-thread.cpp
+/// @brief Raises the ToneDriverSDL2 audio thread to real-time priority, pins it to CPU 0 and reports the result.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include <iostream>
+
+int main()
+{
+    // Initialise audio driver object
+    ToneDriverSDL2 toneDriver;
+
+    toneDriver.setAmplitude(0.5);
+
+    // Applied by the callback thread on its next buffer
+    AudioThreadOptions options;
+    options.priority = AudioThreadPriority::Realtime;
+    options.cpuMask = 0x1; // CPU 0
+    toneDriver.setAudioThreadOptions(options);
+
+    const NoteName notes[] = {NoteName::C, NoteName::E, NoteName::G, NoteName::C};
+    const int octaves[] = {4, 4, 4, 5};
+    toneDriver.playSequence(notes, octaves, 4, 150, 50);
+
+    AudioThreadStatus status = toneDriver.getAudioThreadStatus();
+
+    std::cout << "Requested: " << audioThreadPriorityToString(options.priority) << ", CPU mask 0x" << std::hex << options.cpuMask << std::dec << std::endl;
+
+    if (!status.applied)
+    {
+        std::cout << "Options not applied yet (the audio callback has not run)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Achieved:  " << audioThreadPriorityToString(status.priority) << ", CPU mask 0x" << std::hex << status.cpuMask << std::dec << std::endl;
+
+    if (status.priority != options.priority)
+    {
+        std::cout << "Fell back to a lower priority (on Linux, grant CAP_SYS_NICE or raise RLIMIT_RTPRIO)" << std::endl;
+    }
+
+    return 0;
+}
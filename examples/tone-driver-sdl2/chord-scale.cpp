@@ -2,57 +2,42 @@
 /// @brief Plays a major scale of chords via ToneDriverSDL2.
 
 #include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include "music-driver/MusicDriver.h"
 #include <iostream>
 
 const int START_OCTAVE = 3;
-const int NOTES_PER_CHORD = 3;
-const int NOTES_PER_OCTAVE = 12;
+const int CHORD_DURATION_MS = 400;
 const int REST_DURATION_MS = 100;
-const int MAJOR_SCALE_INTERVALS[] = {2, 2, 1, 2, 2, 2, 1};
 
+// Quality of the triad built on each degree of a major scale
+const ChordQuality MAJOR_SCALE_TRIADS[] = {
+    ChordQuality::Major,
+    ChordQuality::Minor,
+    ChordQuality::Minor,
+    ChordQuality::Major,
+    ChordQuality::Major,
+    ChordQuality::Minor,
+    ChordQuality::Diminished
+};
+const int DEGREES = sizeof(MAJOR_SCALE_TRIADS)/sizeof(MAJOR_SCALE_TRIADS[0]);
 
-void incrementNote(NoteName& note, int& octave, int interval)
-{
-    int intNote = int(note);
-
-    // Increment the note by the given interval (wrap around)
-    if(intNote + interval > int(NoteName::B))
-    {
-        note = NoteName((intNote + interval) % NOTES_PER_OCTAVE);
-        octave++;
-    }
-    else
-    {
-        note = NoteName(intNote + interval);
-    }
-}
 
-
-void decrementNote(NoteName& note, int& octave, int interval)
+void playDegree(ToneDriver& driver, const Key& key, int degree, int durationMs)
 {
-    int intNote = int(note);
-
-    // Decrement the note by the given interval (wrap around)
-    if(intNote - interval < int(NoteName::C))
-    {
-        note = NoteName(((intNote - interval) + NOTES_PER_OCTAVE) % NOTES_PER_OCTAVE);
-        octave--;
-    }
-    else
-    {
-        note = NoteName(intNote - interval);
-    }
-}
+    Chord chord(key.getNote(degree, START_OCTAVE), MAJOR_SCALE_TRIADS[degree % DEGREES]);
+    ChordVoicing voicing = chord.getVoicing();
 
-
-void printChordNotes(const NoteName notes[5], int noteCount)
-{
-    std::cout << "Playing Chord: ";
-    for (int j = 0; j < noteCount; ++j)
+    // Print the notes in the chord
+    std::cout << "Playing Chord " << chord.toString() << ": ";
+    for (int i = 0; i < voicing.count; ++i)
     {
-        std::cout << noteNameToString(notes[j]) << " ";
+        std::cout << noteNameToString(voicing.notes[i]) << voicing.octaves[i] << " ";
     }
     std::cout << std::endl;
+
+    // Play the chord
+    playChord(driver, chord, durationMs);
+    driver.rest(REST_DURATION_MS);
 }
 
 
@@ -62,72 +47,20 @@ int main()
     ToneDriverSDL2 toneDriver;
     toneDriver.setAmplitude(0.5);
 
-    // NoteName and octave arrays are expected to be of length 5
-    // Only the first 3 notes will be used
-    NoteName chordNotes[5] = {
-        NoteName::C, 
-        NoteName::E, 
-        NoteName::G,
-        NoteName::B,
-        NoteName::D
-    };
-    int chordOctaves[5] = {
-        START_OCTAVE, 
-        START_OCTAVE, 
-        START_OCTAVE,
-        START_OCTAVE,
-        START_OCTAVE + 1
-    };
+    Key key(NoteName::C, ScaleType::Major);
 
-    // 7 Ascending intervals
-    for (int i = 0; i < sizeof(MAJOR_SCALE_INTERVALS)/sizeof(MAJOR_SCALE_INTERVALS[0]); ++i)
+    // Ascending chords, holding the tonic at the top
+    for (int degree = 0; degree < DEGREES; ++degree)
     {
-        // Print the notes in the chord
-        printChordNotes(chordNotes, NOTES_PER_CHORD);
-
-        // Play the chord
-        toneDriver.playChord(chordNotes, chordOctaves, NOTES_PER_CHORD);
-        toneDriver.rest(REST_DURATION_MS); 
-        
-        // Increment the notes to the next chord
-        for (int j = 0; j < NOTES_PER_CHORD; ++j)
-        {
-            int interval = MAJOR_SCALE_INTERVALS[(i + (j*2)) % 7];
-            incrementNote(chordNotes[j], chordOctaves[j], interval);
-        }
+        playDegree(toneDriver, key, degree, CHORD_DURATION_MS);
     }
-
-    // Print the notes in the chord
-    printChordNotes(chordNotes, NOTES_PER_CHORD);
-
-    // Play the tonic chord at the end of the ascending scale
-    toneDriver.playChord(chordNotes, chordOctaves, NOTES_PER_CHORD);
-    toneDriver.rest(REST_DURATION_MS * 4);
+    playDegree(toneDriver, key, DEGREES, CHORD_DURATION_MS * 2);
 
     std::cout << "-----------------------------" << std::endl;
 
-    // Print the notes in the chord
-    printChordNotes(chordNotes, NOTES_PER_CHORD);
-
-    // Play the tonic chord again to start the descending scale
-    toneDriver.playChord(chordNotes, chordOctaves, NOTES_PER_CHORD);
-    toneDriver.rest(REST_DURATION_MS); 
-
-    // 7 Descending intervals
-    for (int i = sizeof(MAJOR_SCALE_INTERVALS)/sizeof(MAJOR_SCALE_INTERVALS[0]) - 1; i >= 0; --i)
+    // Descending chords back to the tonic
+    for (int degree = DEGREES; degree >= 0; --degree)
     {
-        // Decrement the notes to the next chord
-        for (int j = 0; j < NOTES_PER_CHORD; ++j)
-        {
-            int interval = MAJOR_SCALE_INTERVALS[(i + (j*2)) % 7];
-            decrementNote(chordNotes[j], chordOctaves[j], interval);
-        }
-
-        // Print the notes in the chord
-        printChordNotes(chordNotes, NOTES_PER_CHORD);
-
-        // Play the chord
-        toneDriver.playChord(chordNotes, chordOctaves, NOTES_PER_CHORD);
-        toneDriver.rest(REST_DURATION_MS); 
+        playDegree(toneDriver, key, degree, CHORD_DURATION_MS);
     }
-}
\ No newline at end of file
+}
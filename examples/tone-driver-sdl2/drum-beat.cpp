@@ -0,0 +1,65 @@
+/// @file drum-beat.cpp
+/// @brief Plays each LFSR noise percussion preset, then a drum beat on the effects bus under a tune on the music bus.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include <iostream>
+
+const int STEP_MS = 125; // Sixteenth notes at 120 BPM
+const int BARS = 4;
+
+
+int main()
+{
+    // Initialise audio driver object
+    ToneDriverSDL2 toneDriver;
+    toneDriver.setAmplitude(0.5);
+
+    // Each preset on its own
+    const char* names[] = {"Snare", "Hi-hat", "Crash", "Tom", "Clank"};
+    const NoiseHit presets[] = {noiseSnare(), noiseHiHat(), noiseCrash(), noiseTom(), noiseClank()};
+
+    for (int i = 0; i < 5; ++i)
+    {
+        std::cout << names[i] << "\n";
+        toneDriver.queueNoise(AudioBus::Effects, presets[i]);
+        toneDriver.queueRest(AudioBus::Effects, 1000 - presets[i].durationMs);
+        toneDriver.waitForBus(AudioBus::Effects);
+    }
+
+    // Drums play alongside the music rather than ducking it
+    AudioBusSettings drums = toneDriver.getBusSettings(AudioBus::Effects);
+    drums.priority = 0;
+    drums.gain = 0.8f;
+    toneDriver.setBusSettings(AudioBus::Effects, drums);
+
+    // One bar of sixteenths: T = tom, S = snare, h = hi-hat, . = rest
+    const char* pattern = "T.h.S.h.T.hTS.hh";
+
+    std::cout << "Beat\n";
+    for (int bar = 0; bar < BARS; ++bar)
+    {
+        const NoteName bass[] = {NoteName::C, NoteName::C, NoteName::G, NoteName::ASharp};
+        toneDriver.queueNote(AudioBus::Music, bass[bar], 2, 16 * STEP_MS);
+
+        for (int step = 0; step < 16; ++step)
+        {
+            NoiseHit hit;
+            switch (pattern[step])
+            {
+                case 'T': hit = noiseTom(); break;
+                case 'S': hit = noiseSnare(); break;
+                case 'h': hit = noiseHiHat(); break;
+                default:  toneDriver.queueRest(AudioBus::Effects, STEP_MS); continue;
+            }
+
+            if (bar == 0 && step == 0) hit = noiseCrash();
+            if (hit.durationMs > STEP_MS) hit.durationMs = STEP_MS; // Keep to the grid
+            toneDriver.queueNoise(AudioBus::Effects, hit);
+            toneDriver.queueRest(AudioBus::Effects, STEP_MS - hit.durationMs);
+        }
+    }
+
+    toneDriver.waitForBus(AudioBus::Effects);
+    toneDriver.waitForBus(AudioBus::Music);
+    return 0;
+}
@@ -0,0 +1,325 @@
+/// @file headless-check.cpp
+/// @brief Runs ToneDriverSDL2 on SDL's disk or dummy audio driver, checks the captured output against the notes played, and checks the callback kept time.
+///
+/// Usage: headless-check [disk|dummy] [capture-file]
+///
+/// No audio hardware is needed, so this can run in CI. With the disk driver the device output
+/// is written to the capture file, split into notes at the rests, and each note's frequency
+/// is measured from its zero crossings. It also checks that the blocking calls return while a
+/// loop plays on the music bus, don't stall music queued there, and that queueing more steps than
+/// a bus holds on a paused device doesn't hang. Exits with 1 if anything is out of tolerance.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+const int NOTE_DURATION_MS = 150;
+const int REST_DURATION_MS = 50;
+const int NOTE_COUNT = 8;
+const NoteName NOTES[NOTE_COUNT] = {NoteName::C, NoteName::E, NoteName::G, NoteName::B, NoteName::D, NoteName::FSharp, NoteName::A, NoteName::C};
+const int OCTAVES[NOTE_COUNT] = {3, 3, 4, 4, 5, 5, 5, 6};
+
+const size_t MIN_GAP_SAMPLES = 44;          // Silence that separates two notes (1 ms)
+const double FREQUENCY_TOLERANCE = 0.001;   // Relative
+const long TIMING_TOLERANCE_SAMPLES = 1;
+const int BLOCKING_TIMEOUT_MS = 5000;       // Longest the blocking calls, or queued music after them, may take
+
+
+/**
+ * @brief A run of sound in the captured output.
+ */
+struct Segment
+{
+    size_t start;       ///< First sample.
+    size_t length;      ///< Number of samples.
+    double frequency;   ///< Measured from rising zero crossings (Hz).
+};
+
+
+// One channel of a raw 16-bit capture
+std::vector<int16_t> readChannel(const std::string& path, int channels, int channel)
+{
+    std::vector<int16_t> samples;
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) return samples;
+
+    std::vector<int16_t> frame(channels);
+    while (std::fread(frame.data(), sizeof(int16_t), channels, file) == size_t(channels))
+    {
+        samples.push_back(frame[channel]);
+    }
+
+    std::fclose(file);
+    return samples;
+}
+
+// Splits the output into notes at silences and measures each one's frequency
+std::vector<Segment> findSegments(const std::vector<int16_t>& samples)
+{
+    std::vector<Segment> segments;
+    size_t i = 0;
+
+    while (i < samples.size())
+    {
+        while (i < samples.size() && samples[i] == 0) ++i;
+        if (i == samples.size()) break;
+
+        size_t start = i;
+        size_t end = i;
+        size_t firstEdge = 0, lastEdge = 0, edges = 0;
+
+        for (size_t silence = 0; i < samples.size() && silence < MIN_GAP_SAMPLES; ++i)
+        {
+            if (samples[i] == 0)
+            {
+                ++silence;
+                continue;
+            }
+
+            silence = 0;
+            end = i + 1;
+
+            if (i > start && samples[i - 1] < 0 && samples[i] > 0)
+            {
+                if (edges++ == 0) firstEdge = i;
+                lastEdge = i;
+            }
+        }
+
+        double frequency = (edges > 1) ? double(edges - 1) * ToneDriverSDL2::SAMPLE_RATE / double(lastEdge - firstEdge) : 0.0;
+        segments.push_back({start, end - start, frequency});
+        i = end;
+    }
+
+    return segments;
+}
+
+// Checks the notes of a capture against the sequence that was played
+bool checkCapture(const std::vector<int16_t>& samples, const char* label)
+{
+    const long noteSamples = long(NOTE_DURATION_MS) * ToneDriverSDL2::SAMPLE_RATE / 1000;
+    const long stepSamples = long(NOTE_DURATION_MS + REST_DURATION_MS) * ToneDriverSDL2::SAMPLE_RATE / 1000;
+    std::vector<Segment> segments = findSegments(samples);
+    bool ok = true;
+
+    if (segments.size() != size_t(NOTE_COUNT))
+    {
+        std::cout << "  " << label << ": FAIL found " << segments.size() << " notes, expected " << NOTE_COUNT << std::endl;
+        return false;
+    }
+
+    for (int i = 0; i < NOTE_COUNT; ++i)
+    {
+        int semitones = (int(NOTES[i]) + 12 * OCTAVES[i]) - (int(NoteName::A) + 12 * 4);
+        double expected = 440.0 * std::pow(2.0, semitones / 12.0);
+        double error = std::fabs(segments[i].frequency - expected) / expected;
+        long lengthError = long(segments[i].length) - noteSamples;
+        long onsetError = (i == 0) ? 0 : long(segments[i].start - segments[i - 1].start) - stepSamples;
+
+        bool noteOk = error <= FREQUENCY_TOLERANCE && std::labs(lengthError) <= TIMING_TOLERANCE_SAMPLES && std::labs(onsetError) <= TIMING_TOLERANCE_SAMPLES;
+        ok = ok && noteOk;
+
+        if (!noteOk)
+        {
+            std::cout << "  " << label << ": FAIL note " << i << " " << segments[i].frequency << " Hz (expected " << expected
+                      << "), length off by " << lengthError << ", onset off by " << onsetError << " samples" << std::endl;
+        }
+    }
+
+    if (ok)
+    {
+        std::cout << "  " << label << ": " << NOTE_COUNT << " notes, frequencies within " << FREQUENCY_TOLERANCE * 100
+                  << "%, lengths and onsets within " << TIMING_TOLERANCE_SAMPLES << " sample" << std::endl;
+    }
+    return ok;
+}
+
+// Checks the callback was never a whole buffer late and always rendered within a buffer
+bool checkTimings(const ToneDriverSDL2& driver)
+{
+    ToneDriverSDL2::CallbackTimings timings = driver.getCallbackTimings();
+    float buffer = driver.getBufferDurationMs();
+    bool ok = timings.callbacks > 0 && timings.maxLatenessMs < buffer && timings.maxRenderMs < buffer;
+
+    std::cout << "  callback: " << timings.callbacks << " buffers of " << buffer << " ms, interval mean "
+              << timings.meanIntervalMs << " ms max " << timings.maxIntervalMs << " ms (late by up to "
+              << timings.maxLatenessMs << " ms), render mean " << timings.meanRenderMs << " ms max "
+              << timings.maxRenderMs << " ms" << (ok ? "" : "  FAIL") << std::endl;
+    return ok;
+}
+
+// Plays the sequence on a fresh driver, optionally panned, and checks the result
+bool runCase(const char* label, int channels, float pan, bool capture, const std::string& path)
+{
+    std::cout << label << "\n";
+    int outputChannels = 0;
+    bool ok = true;
+
+    {
+        ToneDriverSDL2 toneDriver(AudioInitMode::Immediate, channels);
+        toneDriver.setAmplitude(0.5);
+        outputChannels = toneDriver.getOutputChannels();
+
+        AudioBusSettings music = toneDriver.getBusSettings(AudioBus::Music);
+        music.pan = pan;
+        toneDriver.setBusSettings(AudioBus::Music, music);
+
+        toneDriver.playSequence(NOTES, OCTAVES, NOTE_COUNT, NOTE_DURATION_MS, REST_DURATION_MS);
+        ok = checkTimings(toneDriver);
+    } // Closing the device flushes the capture
+
+    if (!capture)
+    {
+        return ok;
+    }
+
+    if (outputChannels == 1)
+    {
+        return checkCapture(readChannel(path, 1, 0), "mono") && ok;
+    }
+
+    // Panned hard left: the left channel carries the notes and the right is silent
+    std::vector<int16_t> left = readChannel(path, outputChannels, 0);
+    std::vector<int16_t> right = readChannel(path, outputChannels, 1);
+    bool rightSilent = findSegments(right).empty();
+    std::cout << "  right: " << (rightSilent ? "silent" : "FAIL not silent") << std::endl;
+
+    return checkCapture(left, "left") && rightSilent && ok;
+}
+
+// Polls a condition until it holds or the timeout passes
+bool waitFor(const std::function<bool()>& condition, int timeoutMs)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
+// Makes each blocking call while a loop plays on the music bus: none may wait for the loop
+bool checkBlockingOverLoop()
+{
+    std::cout << "Blocking calls over a loop\n";
+
+    ToneDriverSDL2 toneDriver;
+    toneDriver.setAmplitude(0.5);
+
+    std::vector<Sint16> loop(ToneDriverSDL2::SAMPLE_RATE / 10);
+    for (size_t i = 0; i < loop.size(); ++i) loop[i] = Sint16((i % 100 < 50) ? 8000 : -8000);
+    toneDriver.queueLoop(AudioBus::Music, loop.data(), int(loop.size()), 0, int(loop.size()) / 2);
+    Uint64 queued = toneDriver.getBusSamplesQueued(AudioBus::Music);
+
+    std::atomic<bool> done{false};
+    std::thread calls([&] {
+        const NoteName chord[] = {NoteName::C, NoteName::E, NoteName::G};
+        const int octaves[] = {4, 4, 4};
+        ToneAutomation vibrato;
+        vibrato.vibratoRateHz = 6.0f;
+        vibrato.vibratoDepthSemitones = 0.5f;
+
+        toneDriver.playSequence(NOTES, OCTAVES, 2, 50, 10);
+        toneDriver.playChord(chord, octaves, 3, 100);
+        toneDriver.playSamples(loop.data(), int(loop.size()));
+        toneDriver.playNote(NoteName::A, 4, 50, vibrato);
+        toneDriver.playFrequency(440.0f, 50, vibrato);
+        done = true;
+    });
+
+    if (!waitFor([&] { return done.load(); }, BLOCKING_TIMEOUT_MS))
+    {
+        std::cout << "  FAIL blocking calls still waiting after " << BLOCKING_TIMEOUT_MS << " ms" << std::endl;
+        std::cout << "FAIL" << std::endl;
+        std::_Exit(1); // The calls can't be joined
+    }
+    calls.join();
+
+    // Passes of the loop are not queued samples, so the bus has finished once the first pass has
+    bool passesUncounted = toneDriver.getBusSamplesQueued(AudioBus::Music) == queued && !toneDriver.isBusPlaying(AudioBus::Music);
+    std::cout << "  blocking calls returned, loop passes " << (passesUncounted ? "not counted as queued" : "FAIL counted as queued") << std::endl;
+
+    toneDriver.clearBus(AudioBus::Music);
+    return passesUncounted;
+}
+
+// Makes blocking calls while music queued on the music bus plays: stopping them must not pause the music
+bool checkBlockingOverMusic()
+{
+    std::cout << "Blocking calls over queued music\n";
+
+    ToneDriverSDL2 toneDriver;
+    toneDriver.setAmplitude(0.5);
+    toneDriver.queueSequence(AudioBus::Music, NOTES, OCTAVES, NOTE_COUNT, NOTE_DURATION_MS, REST_DURATION_MS);
+
+    toneDriver.playNote(NoteName::A, 5, 100);
+    toneDriver.rest(100);
+
+    bool finished = waitFor([&] { return !toneDriver.isBusPlaying(AudioBus::Music); }, BLOCKING_TIMEOUT_MS);
+    std::cout << "  queued music " << (finished ? "played to the end" : "FAIL stalled") << " ("
+              << toneDriver.getBusSamplesRendered(AudioBus::Music) << " of " << toneDriver.getBusSamplesQueued(AudioBus::Music)
+              << " samples)" << std::endl;
+    return finished;
+}
+
+// Queues more steps than the music bus holds before the device has started: the queue must drain rather than hang
+bool checkLongQueueOnPausedDevice()
+{
+    std::cout << "Long queue on a paused device\n";
+
+    const int noteCount = 300; // A note and a rest each, so more steps than the bus queue holds
+    std::vector<NoteName> notes(noteCount, NoteName::A);
+    std::vector<int> octaves(noteCount, 4);
+
+    ToneDriverSDL2 toneDriver;
+    toneDriver.setAmplitude(0.5);
+
+    std::atomic<bool> done{false};
+    std::thread queueing([&] {
+        toneDriver.queueSequence(AudioBus::Music, notes.data(), octaves.data(), noteCount, 2, 2);
+        done = true;
+    });
+
+    if (!waitFor([&] { return done.load(); }, BLOCKING_TIMEOUT_MS))
+    {
+        std::cout << "  FAIL queueSequence still waiting after " << BLOCKING_TIMEOUT_MS << " ms" << std::endl;
+        std::cout << "FAIL" << std::endl;
+        std::_Exit(1); // The call can't be joined
+    }
+    queueing.join();
+
+    bool finished = waitFor([&] { return !toneDriver.isBusPlaying(AudioBus::Music); }, BLOCKING_TIMEOUT_MS);
+    std::cout << "  " << (noteCount * 2) << " steps " << (finished ? "queued and played" : "FAIL queued but stalled") << std::endl;
+    return finished;
+}
+
+
+int main(int argc, char* argv[])
+{
+    std::string driver = (argc > 1) ? argv[1] : "disk";
+    std::string path = (argc > 2) ? argv[2] : "headless-check.raw";
+    bool capture = (driver == "disk");
+
+    // Must be set before SDL initialises audio
+    setenv("SDL_AUDIODRIVER", driver.c_str(), 1);
+    setenv("SDL_DISKAUDIOFILE", path.c_str(), 1);
+
+    bool ok = runCase("Mono", 1, 0.0f, capture, path);
+    ok = runCase("Stereo, panned left", 2, -1.0f, capture, path) && ok;
+    ok = checkBlockingOverLoop() && ok;
+    ok = checkBlockingOverMusic() && ok;
+    ok = checkLongQueueOnPausedDevice() && ok;
+
+    std::cout << (ok ? "PASS" : "FAIL") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+/// @file hot-reload.cpp
+/// @brief Loops a song file through ToneDriverSDL2 and reloads it whenever it is saved.
+///
+/// Usage: hot-reload [song file] [seconds]
+/// Edit the file while it plays: only the changed notes are re-rendered and playback carries on.
+
+#include "tone-driver-sdl2/SongHotReloader.h"
+#include <cstdlib>
+#include <iostream>
+
+const int FRAME_MS = 16;
+const int DEFAULT_RUN_SECONDS = 60;
+
+int main(int argc, char* argv[])
+{
+    const char* path = (argc > 1) ? argv[1] : "examples/songs/demo.song";
+    int runSeconds = (argc > 2) ? std::atoi(argv[2]) : DEFAULT_RUN_SECONDS;
+
+    // Initialise audio driver object
+    ToneDriverSDL2 toneDriver;
+
+    SongHotReloader song(toneDriver, path);
+    if (!song.load())
+    {
+        std::cerr << "Could not load " << path << " (line " << song.getLastReport().errorLine << ")" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Playing " << path << ", edit and save it to hear the changes" << std::endl;
+
+    // A "game loop"
+    for (int elapsedMs = 0; elapsedMs < runSeconds * 1000; elapsedMs += FRAME_MS)
+    {
+        song.update();
+
+        SongReloadReport report;
+        if (song.pollReport(report))
+        {
+            if (!report.ok)
+            {
+                std::cout << "Reload failed at line " << report.errorLine << ", still playing the previous version" << std::endl;
+                continue;
+            }
+
+            std::cout << report.noteCount << " notes, " << report.changedNotes << " re-rendered from note " << report.firstChangedNote
+                      << " (" << report.samplesRendered << " samples rendered, " << report.samplesCopied << " copied) in "
+                      << report.parseMs + report.renderMs << " ms; save to queued " << report.saveToQueuedMs
+                      << " ms, save to audible " << report.saveToAudibleMs << " ms" << std::endl;
+        }
+
+        SDL_Delay(FRAME_MS);
+    }
+
+    return 0;
+}
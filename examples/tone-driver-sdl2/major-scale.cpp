@@ -2,75 +2,14 @@
 /// @brief Plays a major scale via ToneDriverSDL2.
 
 #include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include "music-driver/MusicDriver.h"
 #include <iostream>
 
 const int START_OCTAVE = 3;
 const int NO_OF_OCTAVES = 2;
-const int NOTES_PER_OCTAVE = 12;
 const int NOTE_DURATION_MS = 150;
 const int REST_DURATION_MS = 50;
 const int REST_BETWEEN_SCALES_MS = 200;
-const int MAJOR_SCALE_INTERVALS[] = {2, 2, 1, 2, 2, 2, 1};
-
-void playMajorScale(ToneDriver& driver, NoteName root, int startOctave, int octaves = 1)
-{
-    int note = int(root);
-    int octave = startOctave;
-
-    // Complete multiple octaves of the scale
-    for(int octave_no = 0; octave_no < octaves; ++octave_no)
-    {   
-        // Each octave consists of 7 intervals
-        for (int i = 0; i < sizeof(MAJOR_SCALE_INTERVALS)/sizeof(MAJOR_SCALE_INTERVALS[0]); ++i)
-        {
-            // Play the note
-            std::cout << "Playing Note " << noteNameToString(static_cast<NoteName>(note)) << " Octave " << octave << std::endl;
-            driver.playNote(static_cast<NoteName>(note % NOTES_PER_OCTAVE), octave, NOTE_DURATION_MS);
-            driver.rest(REST_DURATION_MS); 
-            
-            // And then increment the note by the given interval (wrap around)
-            if(note + MAJOR_SCALE_INTERVALS[i] > int(NoteName::B))
-            {
-                note = (note + MAJOR_SCALE_INTERVALS[i]) % NOTES_PER_OCTAVE;
-                octave++;
-            }
-            else
-            {
-                note += MAJOR_SCALE_INTERVALS[i];
-            }
-        }
-    }
-    
-    // Play the highest note of the scale
-    std::cout << "Playing Note " << noteNameToString(static_cast<NoteName>(note)) << " Octave " << octave << std::endl;
-    driver.playNote(static_cast<NoteName>(note % NOTES_PER_OCTAVE), octave, NOTE_DURATION_MS);
-    driver.rest(REST_DURATION_MS);
-
-    // Complete multiple decending octaves of the scale
-    for(int octave_no = octaves; octave_no > 0; --octave_no)
-    {
-        // Each octave consists of 7 intervals
-        for (int i = sizeof(MAJOR_SCALE_INTERVALS)/sizeof(MAJOR_SCALE_INTERVALS[0]) - 1; i >= 0; --i)
-        {
-            // Decrement the note by the given interval (wrap around)
-            if(note - MAJOR_SCALE_INTERVALS[i] < int(NoteName::C))
-            {
-                note = ((note - MAJOR_SCALE_INTERVALS[i]) + NOTES_PER_OCTAVE) % NOTES_PER_OCTAVE;
-                octave--;
-            }
-            else
-            {
-                note -= MAJOR_SCALE_INTERVALS[i];
-            }
-
-            // And play the note
-            std::cout << "Playing Note " << noteNameToString(static_cast<NoteName>(note)) << " Octave " << octave << std::endl;
-            driver.playNote(static_cast<NoteName>(note%NOTES_PER_OCTAVE), octave, NOTE_DURATION_MS);
-            driver.rest(REST_DURATION_MS); 
-        }
-    } 
-}
-
 
 
 int main() 
@@ -80,12 +19,16 @@ int main()
 
     toneDriver.setAmplitude(0.5);
 
-    // Play each of the 12 major scales 
-    for (int root = int(NoteName::C); root <= int(NoteName::B); ++root)
+    // Start on C and transpose up a semitone for each of the 12 major scales
+    Key key(NoteName::C, ScaleType::Major);
+
+    for (int i = 0; i < Note::NOTES_PER_OCTAVE; ++i)
     {
         std::cout << "-------------------------------------------------\n\n";
-        std::cout << "*** " << noteNameToString(static_cast<NoteName>(root)) << " Major Scale ***\n";
-        playMajorScale(toneDriver, static_cast<NoteName>(root), START_OCTAVE, NO_OF_OCTAVES);
+        std::cout << "*** " << noteNameToString(key.getRoot()) << " Major Scale ***\n";
+        playScale(toneDriver, key, START_OCTAVE, NO_OF_OCTAVES, NOTE_DURATION_MS, REST_DURATION_MS);
         toneDriver.rest(REST_BETWEEN_SCALES_MS); 
+
+        key.transpose(1);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,52 @@
+/// @file music-and-effects.cpp
+/// @brief Plays background music and sound effects at the same time on separate ToneDriverSDL2 buses.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include <iostream>
+
+const int NOTE_DURATION_MS = 200;
+const int REST_DURATION_MS = 50;
+const int FRAME_MS = 16;
+const int FRAMES_BETWEEN_EFFECTS = 40;
+
+int main()
+{
+    // Initialise audio driver object
+    ToneDriverSDL2 toneDriver;
+
+    toneDriver.setAmplitude(0.5);
+
+    // Queue the tune without blocking
+    const NoteName tune[] = {NoteName::C, NoteName::E, NoteName::G, NoteName::E, NoteName::F, NoteName::A, NoteName::G, NoteName::E};
+    const int octaves[] = {4, 4, 4, 4, 4, 4, 4, 4};
+    toneDriver.queueSequence(AudioBus::Music, tune, octaves, 8, NOTE_DURATION_MS, REST_DURATION_MS);
+    toneDriver.queueSequence(AudioBus::Music, tune, octaves, 8, NOTE_DURATION_MS, REST_DURATION_MS);
+
+    // A "game loop": fire an effect every so often while the music carries on underneath
+    ToneAutomation coin;
+    coin.glideToFrequency = 1800.0f;
+
+    for (int frame = 0; toneDriver.isBusPlaying(AudioBus::Music); ++frame)
+    {
+        if (frame % FRAMES_BETWEEN_EFFECTS == 0)
+        {
+            std::cout << "Effect (music ducked)\n";
+            toneDriver.queueFrequency(AudioBus::Effects, 900.0f, 120, coin);
+        }
+
+        SDL_Delay(FRAME_MS);
+    }
+
+    // Now let effects pause the music instead, resuming it where it left off
+    AudioBusSettings music = toneDriver.getBusSettings(AudioBus::Music);
+    music.pauseWhenPreempted = true;
+    toneDriver.setBusSettings(AudioBus::Music, music);
+
+    toneDriver.queueSequence(AudioBus::Music, tune, octaves, 8, NOTE_DURATION_MS, REST_DURATION_MS);
+    SDL_Delay(500);
+    std::cout << "Effect (music paused)\n";
+    toneDriver.queueFrequency(AudioBus::Effects, 1200.0f, 300, coin);
+
+    toneDriver.waitForBus(AudioBus::Music);
+    return 0;
+}
@@ -0,0 +1,69 @@
+/// @file music-loop.cpp
+/// @brief Loops background music gaplessly with ToneDriverSDL2::queueLoop while the main thread is free.
+///
+/// The tune is rendered once: an intro that plays once, a section that loops, and an outro
+/// that plays when the loop is released. The audio callback wraps around the loop in place.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include "tone-synth/SegmentedRenderer.h"
+#include <iostream>
+#include <vector>
+
+const int NOTE_MS = 180;
+const int LOOP_SECONDS = 8;
+const int AMPLITUDE = 16384;
+
+const SongNote INTRO[] = {
+    {NoteName::G, 3, NOTE_MS * 2}, {NoteName::B, 3, NOTE_MS * 2}
+};
+const SongNote LOOP[] = {
+    {NoteName::C, 4, NOTE_MS}, {NoteName::E, 4, NOTE_MS}, {NoteName::G, 4, NOTE_MS}, {NoteName::E, 4, NOTE_MS},
+    {NoteName::F, 4, NOTE_MS}, {NoteName::A, 4, NOTE_MS}, {NoteName::G, 4, NOTE_MS}, SongNote::rest(NOTE_MS)
+};
+const SongNote OUTRO[] = {
+    {NoteName::G, 4, NOTE_MS}, {NoteName::C, 5, NOTE_MS * 4}
+};
+
+
+// Samples in a run of notes
+int countSamples(const SongNote* notes, int count)
+{
+    int samples = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        samples += int(staticSongNoteSamples(notes[i], ToneDriverSDL2::SAMPLE_RATE));
+    }
+    return samples;
+}
+
+
+int main()
+{
+    // Render intro, loop and outro into one buffer, once
+    std::vector<SongNote> tune(INTRO, INTRO + 2);
+    tune.insert(tune.end(), LOOP, LOOP + 8);
+    tune.insert(tune.end(), OUTRO, OUTRO + 2);
+
+    SegmentedRenderer renderer(tune, PhaseMode::ResetPerNote, ToneDriverSDL2::SAMPLE_RATE, AMPLITUDE);
+    std::vector<Sint16> pcm(renderer.getSampleCount());
+    renderer.render(pcm.data());
+
+    const int loopStart = countSamples(INTRO, 2);
+    const int loopEnd = loopStart + countSamples(LOOP, 8);
+
+    ToneDriverSDL2 toneDriver;
+    toneDriver.setAmplitude(1.0);
+
+    std::cout << "Looping samples " << loopStart << " to " << loopEnd << " for " << LOOP_SECONDS << " s" << std::endl;
+    toneDriver.queueLoop(AudioBus::Music, pcm.data(), int(pcm.size()), loopStart, loopEnd);
+
+    // The main thread is free: nothing to do until it's time to stop
+    SDL_Delay(LOOP_SECONDS * 1000);
+
+    std::cout << "Releasing the loop: outro" << std::endl;
+    toneDriver.releaseLoop(AudioBus::Music);
+    toneDriver.waitForBus(AudioBus::Music);
+
+    std::cout << "Played " << toneDriver.getBusSamplesRendered(AudioBus::Music) << " samples" << std::endl;
+    return 0;
+}
@@ -0,0 +1,54 @@
+/// @file onset-latency.cpp
+/// @brief Measures time-to-first-sample for notes played via ToneDriverSDL2, with and without a warm device.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include <iostream>
+
+const int NOTE_COUNT = 24;
+const int NOTE_DURATION_MS = 100;
+const int REST_DURATION_MS = 50;
+
+
+void measureOnsets(ToneDriverSDL2& driver, const char* label)
+{
+    float total = 0.0f;
+    float worst = 0.0f;
+    int measured = 0;
+
+    for (int i = 0; i < NOTE_COUNT; ++i)
+    {
+        driver.playNote(static_cast<NoteName>(i % 12), 4, NOTE_DURATION_MS);
+
+        float latency = driver.getOnsetLatencyMs();
+        if (latency >= 0.0f)
+        {
+            total += latency;
+            worst = (latency > worst) ? latency : worst;
+            ++measured;
+        }
+
+        driver.rest(REST_DURATION_MS);
+    }
+
+    float buffer = driver.getBufferDurationMs();
+    float mean = (measured > 0) ? total / measured : 0.0f;
+
+    std::cout << label << ": mean " << mean << " ms, worst " << worst << " ms over " << measured << " notes"
+              << " (one buffer = " << buffer << " ms, " << ((worst <= buffer) ? "within" : "OUTSIDE") << " one buffer)" << std::endl;
+}
+
+
+int main() 
+{
+    // Initialise audio driver object
+    ToneDriverSDL2 toneDriver;
+
+    toneDriver.setAmplitude(0.5);
+
+    // Device paused and restarted for every note
+    measureOnsets(toneDriver, "Cold device");
+
+    // Device opened and primed once, notes gated in the callback
+    toneDriver.setWarmDevice(true);
+    measureOnsets(toneDriver, "Warm device");
+}
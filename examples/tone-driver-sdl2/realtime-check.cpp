@@ -0,0 +1,77 @@
+/// @file realtime-check.cpp
+/// @brief Plays every kind of sound through ToneDriverSDL2 and fails if the audio callback allocated or locked.
+///
+/// Build with `-DTONE_DRIVER_RT_CHECKS=ON` to enable the checks. Returns 1 if any violation was counted.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include "tone-synth/RealtimeGuard.h"
+#include "tone-synth/StaticSong.h"
+#include <iostream>
+#include <vector>
+
+static constexpr SongNote JINGLE[] = {{NoteName::C, 5, 60}, SongNote::rest(20), {NoteName::G, 5, 60}};
+using Jingle = StaticSong<JINGLE>;
+
+
+/**
+ * @brief Checks that the guard really counts by allocating inside one on purpose.
+ *
+ * @return true if the deliberate allocation was counted.
+ */
+bool selfTest()
+{
+    RealtimeGuard::resetViolations();
+    {
+        RealtimeGuard guard;
+        std::vector<int> allocates(64);
+    }
+    bool counted = RealtimeGuard::getViolationCount(RealtimeViolation::Allocation) > 0;
+    RealtimeGuard::resetViolations();
+    return counted;
+}
+
+int main()
+{
+    if (!RealtimeGuard::isEnabled())
+    {
+        std::cout << "Real-time checks are disabled. Configure with -DTONE_DRIVER_RT_CHECKS=ON to enable them." << std::endl;
+        return 0;
+    }
+
+    if (!selfTest())
+    {
+        std::cout << "FAIL: a deliberate allocation inside a RealtimeGuard was not counted" << std::endl;
+        return 1;
+    }
+
+    // Initialise audio driver object
+    ToneDriverSDL2 toneDriver;
+    toneDriver.setAmplitude(0.5);
+    toneDriver.setAudioThreadOptions({AudioThreadPriority::Realtime, 0});
+
+    const NoteName notes[] = {NoteName::C, NoteName::E, NoteName::G};
+    const int octaves[] = {4, 4, 4};
+
+    for (int warm = 0; warm < 2; ++warm)
+    {
+        toneDriver.setWarmDevice(warm == 1);
+
+        toneDriver.playNote(NoteName::A, 4, 50);
+        toneDriver.rest(20);
+        toneDriver.playChord(notes, octaves, 3, 100);
+        toneDriver.playSequence(notes, octaves, 3, 30, 10);
+        toneDriver.playSweep(200.0f, 800.0f, 100);
+        toneDriver.playSamples(Jingle::pcm.data(), int(Jingle::SAMPLE_COUNT));
+    }
+
+    uint64_t total = RealtimeGuard::getTotalViolationCount();
+
+    for (int i = 0; i < int(RealtimeViolation::Count); ++i)
+    {
+        RealtimeViolation violation = static_cast<RealtimeViolation>(i);
+        std::cout << realtimeViolationToString(violation) << ": " << RealtimeGuard::getViolationCount(violation) << std::endl;
+    }
+
+    std::cout << ((total == 0) ? "PASS: the audio callback did not allocate or lock" : "FAIL: the audio callback allocated or locked") << std::endl;
+    return (total == 0) ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+/// @file sound-effects.cpp
+/// @brief Plays some classic game sound effects built from pitch and amplitude automation.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include <iostream>
+
+int main()
+{
+    // Initialise audio driver object
+    ToneDriverSDL2 toneDriver;
+
+    toneDriver.setAmplitude(0.5);
+
+    // Laser: a fast exponential drop
+    std::cout << "Laser\n";
+    toneDriver.playSweep(1800.0f, 200.0f, 200);
+    SDL_Delay(300);
+
+    // Power up: a rising glide with vibrato
+    std::cout << "Power up\n";
+    ToneAutomation powerUp;
+    powerUp.glideToFrequency = 1200.0f;
+    powerUp.vibratoRateHz = 12.0f;
+    powerUp.vibratoDepthSemitones = 0.5f;
+    toneDriver.playFrequency(300.0f, 600, powerUp);
+    SDL_Delay(300);
+
+    // Bent note: a whole tone bend up, fading out
+    std::cout << "Bend and fade\n";
+    ToneAutomation bend;
+    bend.pitchBendSemitones = 2.0f;
+    bend.endAmplitude = 0.0f;
+    toneDriver.playNote(NoteName::E, 4, 800, bend);
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+/// @file startup-time.cpp
+/// @brief Reports ToneDriverSDL2 startup time to first frame and to first audible sample.
+///
+/// Usage: startup-time [immediate|background]
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include <cstring>
+#include <iostream>
+
+const int NOTE_DURATION_MS = 250;
+
+
+int main(int argc, char* argv[]) 
+{
+    bool background = (argc < 2) || (std::strcmp(argv[1], "immediate") != 0);
+
+    // Initialise audio driver object
+    ToneDriverSDL2 toneDriver(background ? AudioInitMode::Background : AudioInitMode::Immediate);
+
+    // Play straight away: in background mode the note is held until the device is ready
+    toneDriver.setAmplitude(0.5);
+    toneDriver.playNote(NoteName::A, 4, NOTE_DURATION_MS);
+
+    ToneDriverSDL2::StartupTimings timings = toneDriver.getStartupTimings();
+
+    std::cout << (background ? "Background" : "Immediate") << " initialisation:" << std::endl;
+    std::cout << "  Time to first frame:          " << timings.constructorMs << " ms" << std::endl;
+    std::cout << "  Time to device ready:         " << timings.deviceReadyMs << " ms" << std::endl;
+    std::cout << "  Time to first audible sample: " << timings.firstSampleMs << " ms" << std::endl;
+}
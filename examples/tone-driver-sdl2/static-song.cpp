@@ -0,0 +1,45 @@
+/// @file static-song.cpp
+/// @brief Plays game jingles that were rendered to PCM at compile time with StaticSong.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include "tone-synth/StaticSong.h"
+#include <iostream>
+
+const int REST_BETWEEN_SONGS_MS = 500;
+
+// Rising arpeggio for a new high score
+static constexpr SongNote HIGH_SCORE[] = {
+    {NoteName::C, 5, 80},
+    {NoteName::E, 5, 80},
+    {NoteName::G, 5, 80},
+    {NoteName::C, 6, 80},
+    SongNote::rest(40),
+    {NoteName::G, 5, 80},
+    {NoteName::C, 6, 320}
+};
+
+// Falling phrase for game over
+static constexpr SongNote GAME_OVER[] = {
+    {NoteName::G, 4, 200},
+    {NoteName::FSharp, 4, 200},
+    {NoteName::F, 4, 200},
+    SongNote::rest(50),
+    {NoteName::E, 4, 600}
+};
+
+using HighScoreSong = StaticSong<HIGH_SCORE, ToneDriverSDL2::SAMPLE_RATE>;
+using GameOverSong = StaticSong<GAME_OVER, ToneDriverSDL2::SAMPLE_RATE, 12000>;
+
+
+int main() 
+{
+    // Initialise audio driver object
+    ToneDriverSDL2 toneDriver;
+
+    std::cout << "Playing high score jingle (" << HighScoreSong::SAMPLE_COUNT << " samples, rendered at compile time)" << std::endl;
+    toneDriver.playSamples(HighScoreSong::pcm.data(), HighScoreSong::SAMPLE_COUNT);
+    toneDriver.rest(REST_BETWEEN_SONGS_MS);
+
+    std::cout << "Playing game over jingle (" << GameOverSong::SAMPLE_COUNT << " samples, rendered at compile time)" << std::endl;
+    toneDriver.playSamples(GameOverSong::pcm.data(), GameOverSong::SAMPLE_COUNT);
+}
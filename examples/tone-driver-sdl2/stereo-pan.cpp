@@ -0,0 +1,57 @@
+/// @file stereo-pan.cpp
+/// @brief Plays music and sound effects on separate sides of a stereo device, then sweeps the music across.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include <iostream>
+
+const int NOTE_DURATION_MS = 200;
+const int REST_DURATION_MS = 50;
+const int FRAME_MS = 16;
+const int SWEEP_FRAMES = 120;
+
+int main()
+{
+    // Initialise audio driver object (stereo by default)
+    ToneDriverSDL2 toneDriver;
+    toneDriver.setAmplitude(0.5);
+
+    std::cout << "Output channels: " << toneDriver.getOutputChannels() << "\n";
+
+    // Music on the left, effects on the right
+    AudioBusSettings music = toneDriver.getBusSettings(AudioBus::Music);
+    music.pan = -0.8f;
+    toneDriver.setBusSettings(AudioBus::Music, music);
+
+    AudioBusSettings effects = toneDriver.getBusSettings(AudioBus::Effects);
+    effects.pan = 0.8f;
+    toneDriver.setBusSettings(AudioBus::Effects, effects);
+
+    const NoteName tune[] = {NoteName::C, NoteName::E, NoteName::G, NoteName::E, NoteName::F, NoteName::A, NoteName::G, NoteName::E};
+    const int octaves[] = {4, 4, 4, 4, 4, 4, 4, 4};
+    toneDriver.queueSequence(AudioBus::Music, tune, octaves, 8, NOTE_DURATION_MS, REST_DURATION_MS);
+
+    ToneAutomation coin;
+    coin.glideToFrequency = 1800.0f;
+
+    std::cout << "Music left, effects right\n";
+    for (int i = 0; i < 3; ++i)
+    {
+        SDL_Delay(500);
+        toneDriver.queueFrequency(AudioBus::Effects, 900.0f, 120, coin);
+    }
+    toneDriver.waitForBus(AudioBus::Music);
+
+    // Sweep the music from left to right while it plays (gains are ramped, so there are no clicks)
+    std::cout << "Music sweeping left to right\n";
+    toneDriver.queueSequence(AudioBus::Music, tune, octaves, 8, NOTE_DURATION_MS, REST_DURATION_MS);
+
+    for (int frame = 0; frame <= SWEEP_FRAMES && toneDriver.isBusPlaying(AudioBus::Music); ++frame)
+    {
+        music.pan = -1.0f + (2.0f * frame / SWEEP_FRAMES);
+        toneDriver.setBusSettings(AudioBus::Music, music);
+        SDL_Delay(FRAME_MS);
+    }
+
+    toneDriver.waitForBus(AudioBus::Music);
+    return 0;
+}
@@ -0,0 +1,44 @@
+/// @file terminal-synth.cpp
+/// @brief Plays ToneDriverSDL2 as a keyboard synth in the terminal and reports the key-to-sound latency.
+///
+/// Usage: terminal-synth [bufferSamples] [waveform]
+/// where waveform is one of buzzer, square, pulse, triangle or saw. Smaller buffers lower the
+/// latency; try 128 or 64 if the device allows it without crackling.
+
+#include "tone-driver-sdl2/TerminalSynth.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    int bufferSamples = (argc > 1) ? std::atoi(argv[1]) : 256;
+
+    const char* names[] = {"buzzer", "square", "pulse", "triangle", "saw"};
+    const Waveform waveforms[] = {Waveform::Buzzer, Waveform::Square, Waveform::Pulse, Waveform::Triangle, Waveform::Saw};
+    Waveform waveform = Waveform::Square;
+    for (int i = 0; argc > 2 && i < 5; ++i)
+    {
+        if (std::strcmp(argv[2], names[i]) == 0) waveform = waveforms[i];
+    }
+
+    // Initialise audio driver object with a small buffer, kept running so notes don't wait for the device to start
+    ToneDriverSDL2 toneDriver(AudioInitMode::Immediate, ToneDriverSDL2::DEFAULT_CHANNELS, bufferSamples);
+    toneDriver.setAmplitude(0.15); // Live notes add up, so leave room for chords
+    toneDriver.setWarmDevice(true);
+
+    AudioBusSettings music = toneDriver.getBusSettings(AudioBus::Music);
+    music.waveform = waveform;
+    toneDriver.setBusSettings(AudioBus::Music, music);
+
+    std::cout << "Buffer: " << toneDriver.getBufferDurationMs() << " ms" << std::endl;
+
+    TerminalSynth synth(toneDriver);
+    int notes = synth.run();
+
+    ToneDriverSDL2::NoteOnLatency latency = toneDriver.getNoteOnLatency();
+    std::cout << notes << " notes, key to first sample: mean " << latency.meanMs << " ms, worst " << latency.maxMs
+              << " ms (heard up to " << toneDriver.getBufferDurationMs() << " ms later)" << std::endl;
+
+    return 0;
+}
@@ -6,7 +6,7 @@
 
 const int MIN_FREQ = 16;
 const int MAX_FREQ = 1975;
-const int NOTE_DURATION_MS = 10;
+const int SWEEP_DURATION_MS = 19600;
 
 int main() 
 {
@@ -15,15 +15,8 @@ int main()
 
     toneDriver.setAmplitude(0.5);
 
-    //toneDriver.playNote(Note::A, 4, NOTE_DURATION_MS);
+    std::cout << "Sweeping from " << MIN_FREQ << " Hz to " << MAX_FREQ << " Hz\n";
 
-    for(int freq = MIN_FREQ; freq <= MAX_FREQ; ++freq)
-    {
-        if(freq % 10 == 0)
-        {
-            std::cout << freq << " Hz\n";
-        }
-        
-        toneDriver.playFrequency(freq, NOTE_DURATION_MS);
-    }
-}
\ No newline at end of file
+    // One call: the glide is rendered smoothly by the audio callback
+    toneDriver.playSweep(MIN_FREQ, MAX_FREQ, SWEEP_DURATION_MS, GlideCurve::Linear);
+}
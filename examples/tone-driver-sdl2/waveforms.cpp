@@ -0,0 +1,37 @@
+/// @file waveforms.cpp
+/// @brief Plays the same high phrase with each waveform, from the 1-bit square to the band-limited wavetables.
+
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include <iostream>
+
+const int NOTE_DURATION_MS = 150;
+const int REST_DURATION_MS = 30;
+
+int main()
+{
+    // Initialise audio driver object
+    ToneDriverSDL2 toneDriver;
+    toneDriver.setAmplitude(0.4);
+
+    const NoteName phrase[] = {NoteName::C, NoteName::E, NoteName::G, NoteName::C, NoteName::G, NoteName::E, NoteName::C};
+    const int octaves[] = {5, 5, 5, 6, 5, 5, 5};
+
+    const char* names[] = {"Buzzer (1-bit square)", "Square", "Pulse 12.5%", "Pulse 25%", "Triangle", "Saw"};
+    const Waveform waveforms[] = {Waveform::Buzzer, Waveform::Square, Waveform::Pulse, Waveform::Pulse, Waveform::Triangle, Waveform::Saw};
+    const float pulseWidths[] = {0.5f, 0.5f, 0.125f, 0.25f, 0.5f, 0.5f};
+
+    for (int i = 0; i < 6; ++i)
+    {
+        std::cout << names[i] << std::endl;
+
+        AudioBusSettings music = toneDriver.getBusSettings(AudioBus::Music);
+        music.waveform = waveforms[i];
+        music.pulseWidth = pulseWidths[i];
+        toneDriver.setBusSettings(AudioBus::Music, music);
+
+        toneDriver.playSequence(phrase, octaves, 7, NOTE_DURATION_MS, REST_DURATION_MS);
+        toneDriver.rest(300);
+    }
+
+    return 0;
+}
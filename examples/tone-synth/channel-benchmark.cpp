@@ -0,0 +1,82 @@
+/// @file channel-benchmark.cpp
+/// @brief Renders thousands of independent square wave channels with ChannelRenderer and reports channels-per-core.
+///
+/// Usage: channel-benchmark [channels] [buffer samples] [threads]
+
+#include "tone-synth/ChannelRenderer.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+const int DEFAULT_CHANNELS = 4096;
+const int DEFAULT_BUFFER_SAMPLES = 1024;
+const int BUFFERS_TO_RENDER = 200;
+
+
+// Seconds taken to render one buffer of every channel, averaged over BUFFERS_TO_RENDER buffers
+double timeRender(ChannelRenderer& renderer, int16_t* const outputs[], int bufferSamples)
+{
+    renderer.render(outputs, bufferSamples); // Warm up caches and workers
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BUFFERS_TO_RENDER; ++i)
+    {
+        renderer.render(outputs, bufferSamples);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return elapsed.count() / BUFFERS_TO_RENDER;
+}
+
+
+int main(int argc, char* argv[])
+{
+    int channels = (argc > 1) ? std::atoi(argv[1]) : DEFAULT_CHANNELS;
+    int bufferSamples = (argc > 2) ? std::atoi(argv[2]) : DEFAULT_BUFFER_SAMPLES;
+    int threads = (argc > 3) ? std::atoi(argv[3]) : int(std::thread::hardware_concurrency());
+    if (channels < 1 || bufferSamples < 1) return 1;
+    if (threads < 1) threads = 1;
+
+    ChannelRenderer renderer(channels);
+
+    // Give every channel its own note so no two games sound alike
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        renderer.setNote(channel, static_cast<NoteName>(channel % 12), 1 + (channel / 12) % 6);
+        renderer.setAmplitude(channel, 0.5f);
+    }
+
+    // One separate output buffer per channel
+    std::vector<int16_t> storage(size_t(channels) * bufferSamples);
+    std::vector<int16_t*> outputs(channels);
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        outputs[channel] = &storage[size_t(channel) * bufferSamples];
+    }
+
+    double bufferSeconds = double(bufferSamples) / renderer.getSampleRate();
+
+    std::cout << "Rendering " << channels << " channels x " << bufferSamples << " samples ("
+              << bufferSeconds * 1000.0 << " ms buffer) using " << ChannelRenderer::getInstructionSet() << std::endl;
+
+    // Single core: how many channels one core can keep up with in real time
+    double singleSeconds = timeRender(renderer, outputs.data(), bufferSamples);
+    double channelsPerCore = channels * (bufferSeconds / singleSeconds);
+
+    std::cout << "1 thread:  " << singleSeconds * 1e6 << " us per buffer, "
+              << (singleSeconds * 1e9) / (double(channels) * bufferSamples) << " ns per sample, "
+              << channelsPerCore << " real-time channels per core" << std::endl;
+
+    // All cores, channels partitioned between threads
+    if (threads > 1)
+    {
+        renderer.setThreadCount(threads);
+        double parallelSeconds = timeRender(renderer, outputs.data(), bufferSamples);
+        double totalChannels = channels * (bufferSeconds / parallelSeconds);
+
+        std::cout << threads << " threads: " << parallelSeconds * 1e6 << " us per buffer, "
+                  << totalChannels << " real-time channels total, "
+                  << totalChannels / threads << " per core (speedup " << singleSeconds / parallelSeconds << "x)" << std::endl;
+    }
+}
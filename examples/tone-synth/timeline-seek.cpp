@@ -0,0 +1,123 @@
+/// @file timeline-seek.cpp
+/// @brief Seeks to random points of a long song with TimelineIndex, checks playback from there matches a full render and compares the seek time with a scan from the start.
+///
+/// Usage: timeline-seek [minutes]
+
+#include "tone-synth/TimelineIndex.h"
+#include "tone-synth/SegmentedRenderer.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+const int DEFAULT_MINUTES = 60;
+const int SEEKS = 100000;
+const int CHECKS = 200;
+const size_t CHUNK_SAMPLES = 2048;
+const int AMPLITUDE = 16384;
+
+
+// Phase at a sample found the slow way: every note from the start of the song
+uint32_t scanPhase(const std::vector<SongNote>& song, size_t sample)
+{
+    uint32_t phase = 0;
+    size_t start = 0;
+
+    for (const SongNote& note : song)
+    {
+        size_t length = staticSongNoteSamples(note, TimelineIndex::DEFAULT_SAMPLE_RATE);
+        uint32_t increment = note.isRest ? 0 : staticSongPhaseIncrement(note, TimelineIndex::DEFAULT_SAMPLE_RATE);
+        if (sample < start + length) return phase + increment * uint32_t(sample - start);
+        phase += increment * uint32_t(length);
+        start += length;
+    }
+    return phase;
+}
+
+
+int main(int argc, char* argv[])
+{
+    int minutes = (argc > 1) ? std::atoi(argv[1]) : DEFAULT_MINUTES;
+    if (minutes < 1) return 1;
+
+    // A wandering melody with odd note lengths and rests, so seek points land mid-note
+    std::vector<SongNote> song;
+    for (int elapsedMs = 0, i = 0; elapsedMs < minutes * 60000; ++i)
+    {
+        int durationMs = 37 + (i * 53) % 211;
+        if (i % 7 == 6)
+        {
+            song.push_back(SongNote::rest(durationMs));
+        }
+        else
+        {
+            song.push_back(SongNote{static_cast<NoteName>((i * 5) % 12), 2 + (i / 12) % 4, durationMs});
+        }
+        elapsedMs += durationMs;
+    }
+
+    TimelineIndex index(song);
+    SegmentedRenderer reference(song, PhaseMode::Continuous, SegmentedRenderer::DEFAULT_SAMPLE_RATE, AMPLITUDE);
+    std::mt19937_64 random(1);
+    std::uniform_int_distribution<size_t> anySample(0, index.getSampleCount() - 1);
+
+    std::cout << song.size() << " notes, " << index.getSampleCount() << " samples (" << minutes << " min), index "
+              << index.getMemoryBytes() / 1024 << " KiB, checkpoint every " << index.getCheckpointInterval() << " notes\n";
+
+    // Play a few chunks from random points and compare with the reference render
+    std::vector<int16_t> played(CHUNK_SAMPLES * 3);
+    std::vector<int16_t> expected(CHUNK_SAMPLES * 3);
+    for (int i = 0; i < CHECKS; ++i)
+    {
+        size_t sample = anySample(random);
+        TimelinePosition position = index.seek(sample);
+
+        size_t count = 0;
+        for (int chunk = 0; chunk < 3; ++chunk)
+        {
+            count += index.render(position, played.data() + count, CHUNK_SAMPLES, AMPLITUDE);
+        }
+
+        reference.renderRange(sample, count, expected.data());
+
+        if (std::memcmp(played.data(), expected.data(), count * sizeof(int16_t)) != 0 || position.sample != sample + count)
+        {
+            std::cout << "Playback from sample " << sample << " DIFFERS from the full render" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "Playback from " << CHECKS << " random points matches the full render\n";
+
+    // Time indexed seeks against scanning from the start
+    uint32_t check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SEEKS; ++i)
+    {
+        check += index.seek(anySample(random)).phase;
+    }
+    std::chrono::duration<double, std::micro> indexed = std::chrono::steady_clock::now() - start;
+
+    const int scans = 100;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < scans; ++i)
+    {
+        size_t sample = anySample(random);
+        uint32_t phase = scanPhase(song, sample);
+        if (phase != index.seek(sample).phase)
+        {
+            std::cout << "Phase at sample " << sample << " DIFFERS from a scan" << std::endl;
+            return 1;
+        }
+        check += phase;
+    }
+    std::chrono::duration<double, std::micro> scanned = std::chrono::steady_clock::now() - start;
+
+    double indexedUs = indexed.count() / SEEKS;
+    double scannedUs = scanned.count() / scans;
+    std::cout << "Seek: " << indexedUs << " us indexed, " << scannedUs << " us scanning from the start ("
+              << scannedUs / indexedUs << "x) [" << (check & 1) << "]" << std::endl;
+
+    return 0;
+}
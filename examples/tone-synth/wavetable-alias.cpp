@@ -0,0 +1,90 @@
+/// @file wavetable-alias.cpp
+/// @brief Measures the aliasing of each Voice waveform on a high note and the cost per sample of the wavetable lookup.
+///
+/// Usage: wavetable-alias [frequency]
+///
+/// A 0.1 second window is analysed with a DFT whose bins fall on every harmonic (the frequency
+/// is rounded to a multiple of 10 Hz), so any energy between the harmonics is aliasing.
+
+#include "tone-synth/Voice.h"
+#include "tone-synth/Wavetable.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+const int SAMPLE_RATE = 44100;
+const int WINDOW = SAMPLE_RATE / 10;    // 10 Hz bins
+const int DEFAULT_FREQUENCY = 2630;     // About E7
+const int TIMED_SAMPLES = SAMPLE_RATE * 20;
+
+
+// Energy between the harmonics relative to the energy on them, in dB
+double measureAliasing(const std::vector<float>& samples, int frequency, const std::vector<double>& cosTable, const std::vector<double>& sinTable)
+{
+    const int harmonicBins = frequency / 10;
+    double harmonicEnergy = 0.0, aliasEnergy = 0.0;
+
+    for (int bin = 1; bin <= WINDOW / 2; ++bin)
+    {
+        double re = 0.0, im = 0.0;
+        for (int n = 0, index = 0; n < WINDOW; ++n, index = (index + bin) % WINDOW)
+        {
+            re += samples[n] * cosTable[index];
+            im -= samples[n] * sinTable[index];
+        }
+
+        double energy = (re * re) + (im * im);
+        if (bin % harmonicBins == 0) harmonicEnergy += energy;
+        else aliasEnergy += energy;
+    }
+
+    return 10.0 * std::log10(aliasEnergy / harmonicEnergy);
+}
+
+
+int main(int argc, char* argv[])
+{
+    int frequency = ((argc > 1) ? std::atoi(argv[1]) : DEFAULT_FREQUENCY) / 10 * 10;
+    if (frequency < 10 || frequency >= SAMPLE_RATE / 2) return 1;
+
+    auto start = std::chrono::steady_clock::now();
+    const WavetableBank& bank = WavetableBank::get();
+    std::chrono::duration<double, std::milli> buildMs = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Tables: " << bank.getMemoryBytes() / 1024 << " KiB, built in " << buildMs.count() << " ms\n"
+              << "Note: " << frequency << " Hz (mip level " << WavetableBank::getMipLevel(uint64_t(double(frequency) / SAMPLE_RATE * 18446744073709551616.0)) << ")\n";
+
+    std::vector<double> cosTable(WINDOW), sinTable(WINDOW);
+    for (int i = 0; i < WINDOW; ++i)
+    {
+        cosTable[i] = std::cos(2.0 * 3.141592653589793 * i / WINDOW);
+        sinTable[i] = std::sin(2.0 * 3.141592653589793 * i / WINDOW);
+    }
+
+    const char* names[] = {"Buzzer (1-bit)", "Square", "Pulse 25%", "Triangle", "Saw"};
+    const Waveform waveforms[] = {Waveform::Buzzer, Waveform::Square, Waveform::Pulse, Waveform::Triangle, Waveform::Saw};
+
+    for (int i = 0; i < 5; ++i)
+    {
+        Voice voice;
+        voice.setWaveform(waveforms[i]);
+        voice.start(float(frequency), SAMPLE_RATE);
+
+        std::vector<float> window(WINDOW);
+        for (float& sample : window) sample = voice.nextSample();
+        double aliasDb = measureAliasing(window, frequency, cosTable, sinTable);
+
+        // Cost per sample, including the voice's own bookkeeping
+        float sink = 0.0f;
+        auto timed = std::chrono::steady_clock::now();
+        for (int n = 0; n < TIMED_SAMPLES; ++n) sink += voice.nextSample();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - timed;
+
+        std::cout << "  " << names[i] << ": aliasing " << aliasDb << " dB, "
+                  << elapsed.count() / TIMED_SAMPLES << " ns/sample" << ((sink == 12345.0f) ? " " : "") << std::endl;
+    }
+
+    return 0;
+}
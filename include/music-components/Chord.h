@@ -0,0 +1,151 @@
+/// @file Chord.h
+/// @brief Definition of the Chord class which represents a root Note with a chord quality (Major, Minor...).
+
+#ifndef CHORD_H
+#define CHORD_H
+
+#include <stdint.h>    // for uint8_t, int8_t
+#include "NoteName.h"
+#include "music-components/Note.h"
+
+
+/**
+ * @enum ChordQuality
+ * @brief Chord qualities with a precomputed interval shape.
+ */
+enum class ChordQuality {
+    Major,
+    Minor,
+    Diminished,
+    Augmented,
+    Sus2,
+    Sus4,
+    Major7,
+    Minor7,
+    Dominant7,
+    Diminished7,
+    HalfDiminished7,
+    Dominant9
+};
+
+/**
+ * @enum ChordVoicingStyle
+ * @brief How the notes of a chord are spread across octaves.
+ */
+enum class ChordVoicingStyle {
+    Close,  ///< All notes within one octave of the bass note.
+    Drop2,  ///< Close voicing with the second-highest note dropped an octave.
+    Spread  ///< Close voicing with the bass note dropped an octave.
+};
+
+
+/**
+ * @struct ChordVoicing
+ * @brief The notes of a voiced chord, lowest first, in the parallel array form taken by ToneDriver::playChord.
+ *
+ * Fixed-size storage, so building a voicing never allocates.
+ */
+struct ChordVoicing
+{
+    static constexpr int MAX_NOTES = 5;     ///< Maximum number of notes in a chord (matches the ToneDriver polyphony limit).
+
+    NoteName notes[MAX_NOTES];              ///< Pitch class of each note.
+    int octaves[MAX_NOTES];                 ///< Octave of each note.
+    int count = 0;                          ///< Number of notes in use.
+};
+
+
+/// @class Chord
+/// @brief Represents a chord: a root Note and a ChordQuality (e.g. D minor 7 rooted on D3).
+///
+/// Interval shapes come from a compile-time table, and voicings are generated into fixed-size
+/// ChordVoicing values, so no part of the chord ever allocates.
+class Chord
+{
+public:
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+    /// @brief Default constructor. Initialises to a C4 major triad.
+    Chord();
+
+    /// @brief Constructs a chord on the given root.
+    /// @param root The root note (the octave sets the register of the chord).
+    /// @param quality The chord quality.
+    Chord(const Note& root, ChordQuality quality);
+
+
+// ----------------------------------------- H E L P E R S -----------------------------------------
+    /// @brief Voices the chord.
+    /// @param inversion Number of times to move the lowest note up an octave (0 is root position).
+    /// @param style How to spread the inverted chord across octaves.
+    /// @return The voiced notes, lowest first. If the voicing would leave the valid note range,
+    ///         it is shifted by whole octaves to fit.
+    ChordVoicing getVoicing(int inversion = 0, ChordVoicingStyle style = ChordVoicingStyle::Close) const;
+
+    /// @brief Returns a string representation of the chord (e.g. "Dm7").
+    /// @return C-style string, valid until next call.
+    /// @note Uses static buffer; not safe for multiple simultaneous calls (fine if output is immediately printed).
+    const char* toString() const;
+
+
+// ----------------------------------------- S E T T E R S -----------------------------------------
+    /// @brief Sets the root note of the chord.
+    /// @param newRoot The new root.
+    void setRoot(const Note& newRoot);
+
+    /// @brief Sets the quality of the chord.
+    /// @param newQuality The new quality.
+    void setQuality(const ChordQuality newQuality);
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+    /// @brief Gets the root note.
+    const Note& getRoot() const;
+
+    /// @brief Gets the chord quality.
+    ChordQuality getQuality() const;
+
+    /// @brief Gets the number of notes in the chord.
+    int getNoteCount() const;
+
+    /// @brief Gets the semitone offset of a chord tone above the root (root position).
+    /// @param index Index of the chord tone (0 is the root).
+    /// @return Semitones above the root, or 0 if the index is out of range.
+    int getInterval(int index) const;
+
+
+
+    static constexpr int MAX_NOTES = ChordVoicing::MAX_NOTES;   ///< Maximum number of notes in a chord.
+
+private:
+    /**
+     * @struct Shape
+     * @brief Interval shape of a chord quality.
+     */
+    struct Shape
+    {
+        uint8_t count;                  ///< Number of chord tones.
+        int8_t intervals[MAX_NOTES];    ///< Semitones above the root of each tone, ascending.
+        const char* suffix;             ///< Symbol suffix (e.g. "m7").
+    };
+
+    /// @brief Interval shapes for each ChordQuality, in enum order.
+    static constexpr Shape SHAPES[] = {
+        {3, {0, 4, 7},          ""},     // Major
+        {3, {0, 3, 7},          "m"},    // Minor
+        {3, {0, 3, 6},          "dim"},  // Diminished
+        {3, {0, 4, 8},          "aug"},  // Augmented
+        {3, {0, 2, 7},          "sus2"}, // Sus2
+        {3, {0, 5, 7},          "sus4"}, // Sus4
+        {4, {0, 4, 7, 11},      "maj7"}, // Major7
+        {4, {0, 3, 7, 10},      "m7"},   // Minor7
+        {4, {0, 4, 7, 10},      "7"},    // Dominant7
+        {4, {0, 3, 6, 9},       "dim7"}, // Diminished7
+        {4, {0, 3, 6, 10},      "m7b5"}, // HalfDiminished7
+        {5, {0, 4, 7, 10, 14},  "9"}     // Dominant9
+    };
+
+    Note root_;             ///< The root note of the chord.
+    ChordQuality quality_;  ///< The quality of the chord.
+};
+
+#endif // CHORD_H
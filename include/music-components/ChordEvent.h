@@ -0,0 +1,54 @@
+/// @file ChordEvent.h
+/// @brief Definition of the ChordEvent class which represents a Chord with a duration.
+
+#ifndef CHORD_EVENT_H
+#define CHORD_EVENT_H
+
+#include "music-components/Chord.h"
+
+
+/// @class ChordEvent
+/// @brief Represents a Chord played for a duration, optionally inverted and voiced.
+class ChordEvent
+{
+public:
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+    /// @brief Default constructor. A C4 major triad for the default duration.
+    ChordEvent();
+
+    /// @brief Constructs a chord event.
+    /// @param chord The chord to play.
+    /// @param durationMs How long to play the chord for (in ms).
+    /// @param inversion The inversion to voice the chord in (0 is root position).
+    /// @param style How to spread the chord across octaves.
+    ChordEvent(const Chord& chord, int durationMs, int inversion = 0, ChordVoicingStyle style = ChordVoicingStyle::Close);
+
+
+// ----------------------------------------- S E T T E R S -----------------------------------------
+    /// @brief Sets the chord.
+    void setChord(const Chord& newChord);
+
+    /// @brief Sets the duration. Negative durations are ignored.
+    void setDurationMs(int newDurationMs);
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+    /// @brief Gets the chord.
+    const Chord& getChord() const;
+
+    /// @brief Gets the duration (in ms).
+    int getDurationMs() const;
+
+    /// @brief Gets the voiced notes of the chord.
+    ChordVoicing getVoicing() const;
+
+private:
+    Chord chord_;               ///< The chord to play.
+    int durationMs_;            ///< How long to play the chord for (in ms).
+    int inversion_;             ///< The inversion to voice the chord in.
+    ChordVoicingStyle style_;   ///< How to spread the chord across octaves.
+
+    static constexpr int DEFAULT_DURATION_MS = 500; ///< Default chord duration.
+};
+
+#endif // CHORD_EVENT_H
@@ -0,0 +1,81 @@
+/// @file Key.h
+/// @brief Definition of the Key class which represents a Scale built on a root pitch class.
+
+#ifndef KEY_H
+#define KEY_H
+
+#include <stdint.h>    // for uint8_t, uint16_t
+#include "NoteName.h"
+#include "music-components/Note.h"
+#include "music-components/Scale.h"
+
+
+/// @class Key
+/// @brief Represents a key: a root pitch class and a Scale (e.g. D Dorian).
+///
+/// The notes in the key are held as a 12-bit pitch-class mask, so membership tests are O(1)
+/// and transposition is a bit rotation of the mask.
+class Key
+{
+public:
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+    /// @brief Default constructor. Initialises to C major.
+    Key();
+
+    /// @brief Constructs a key from a root and one of the common scales.
+    /// @param root The root pitch class.
+    /// @param type The scale or mode.
+    Key(NoteName root, ScaleType type);
+
+    /// @brief Constructs a key from a root and a scale.
+    /// @param root The root pitch class.
+    /// @param scale The scale built on the root.
+    /// If the root is not valid, it will be reset to the default (C)
+    Key(NoteName root, const Scale& scale);
+
+
+// ----------------------------------------- H E L P E R S -----------------------------------------
+    /// @brief Checks whether a pitch class is in the key.
+    /// @param note The pitch class.
+    /// @return True if the pitch class is in the key, false otherwise.
+    bool contains(NoteName note) const;
+
+    /// @brief Checks whether a note is in the key (octave is ignored).
+    /// @param note The note.
+    /// @return True if the note's pitch class is in the key, false otherwise.
+    bool contains(const Note& note) const;
+
+    /// @brief Returns the note at a degree of the key.
+    /// @param degree Zero-based degree (0 is the root). Degrees beyond the top of the scale continue into higher octaves.
+    /// @param octave The octave of the root.
+    /// @return The note. If the note is out of range, it will be reset to the default (C4).
+    Note getNote(int degree, uint8_t octave) const;
+
+    /// @brief Transposes the key in-place by rotating its pitch-class mask.
+    /// @param semitones Number of semitones to transpose by (may be negative).
+    void transpose(int semitones);
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+    /// @brief Gets the root pitch class.
+    NoteName getRoot() const;
+
+    /// @brief Gets the scale relative to the root.
+    const Scale& getScale() const;
+
+    /// @brief Gets the absolute pitch-class mask (bit n set if NoteName(n) is in the key).
+    uint16_t getPitchClassMask() const;
+
+    /// @brief Gets the number of degrees in one octave of the key.
+    int getDegreeCount() const;
+
+private:
+    NoteName root_;             ///< The root pitch class of the key.
+    Scale scale_;               ///< The scale relative to the root.
+    uint16_t pitchClassMask_;   ///< The scale mask rotated onto the root.
+
+    static constexpr NoteName DEFAULT_ROOT = NoteName::C;       ///< Default root (C).
+    static constexpr ScaleType DEFAULT_SCALE = ScaleType::Major; ///< Default scale (Major).
+};
+
+#endif // KEY_H
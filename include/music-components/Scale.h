@@ -0,0 +1,124 @@
+/// @file Scale.h
+/// @brief Definition of the Scale class which represents a scale as a set of pitch classes above a root.
+
+#ifndef SCALE_H
+#define SCALE_H
+
+#include <stdint.h>    // for uint16_t, int8_t
+
+
+/**
+ * @enum ScaleType
+ * @brief Common scales and modes with a precomputed pitch-class mask.
+ */
+enum class ScaleType {
+    Major,
+    NaturalMinor,
+    HarmonicMinor,
+    MelodicMinor,
+    Dorian,
+    Phrygian,
+    Lydian,
+    Mixolydian,
+    Locrian,
+    MajorPentatonic,
+    MinorPentatonic,
+    Blues,
+    Chromatic
+};
+
+
+/// @class Scale
+/// @brief Represents a scale as a 12-bit mask of semitones above the root.
+///
+/// Bit n of the mask is set if the note n semitones above the root is in the scale.
+/// Membership tests are a single shift and mask, and the semitone offset of every degree
+/// is precomputed when the scale is constructed (at compile time where possible).
+class Scale
+{
+public:
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+    /// @brief Constructs one of the common scales from the constexpr mask table.
+    /// @param type The scale or mode.
+    constexpr Scale(ScaleType type) : Scale(SCALE_MASKS[int(type)]) {}
+
+    /// @brief Constructs a scale from a raw pitch-class mask.
+    /// @param mask 12-bit mask where bit n means "n semitones above the root".
+    /// The root (bit 0) is always included.
+    constexpr explicit Scale(uint16_t mask) : mask_((mask & FULL_MASK) | 1u)
+    {
+        for (int semitone = 0; semitone < NOTES_PER_OCTAVE; ++semitone)
+        {
+            if ((mask_ >> semitone) & 1u)
+            {
+                intervals_[degreeCount_++] = int8_t(semitone);
+            }
+        }
+    }
+
+
+// ----------------------------------------- H E L P E R S -----------------------------------------
+    /// @brief Checks whether the note a number of semitones above the root is in the scale.
+    /// @param semitones Semitones above the root (any non-negative value, wraps every octave).
+    /// @return True if the note is in the scale, false otherwise.
+    constexpr bool contains(int semitones) const
+    {
+        return (mask_ >> (semitones % NOTES_PER_OCTAVE)) & 1u;
+    }
+
+    /// @brief Returns the semitone offset of a degree above the root.
+    /// @param degree Zero-based degree. Degrees beyond the top of the scale continue into higher octaves.
+    /// @return Semitones above the root.
+    constexpr int getInterval(int degree) const
+    {
+        return intervals_[degree % degreeCount_] + (NOTES_PER_OCTAVE * (degree / degreeCount_));
+    }
+
+    /// @brief Rotates a pitch-class mask by a number of semitones (transposition).
+    /// @param mask 12-bit pitch-class mask.
+    /// @param semitones Semitones to rotate upwards by (wraps every octave, may be negative).
+    /// @return The rotated mask.
+    static constexpr uint16_t rotate(uint16_t mask, int semitones)
+    {
+        int shift = ((semitones % NOTES_PER_OCTAVE) + NOTES_PER_OCTAVE) % NOTES_PER_OCTAVE;
+        return uint16_t(((mask << shift) | (mask >> (NOTES_PER_OCTAVE - shift))) & FULL_MASK);
+    }
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+    /// @brief Gets the pitch-class mask relative to the root.
+    constexpr uint16_t getMask() const { return mask_; }
+
+    /// @brief Gets the number of degrees in one octave of the scale (e.g. 7 for major).
+    constexpr int getDegreeCount() const { return degreeCount_; }
+
+
+
+    static constexpr int NOTES_PER_OCTAVE = 12;         ///< The number of semitones in an octave.
+    static constexpr uint16_t FULL_MASK = 0x0FFF;       ///< Mask with all 12 pitch classes set.
+    static constexpr int MAX_DEGREES = NOTES_PER_OCTAVE; ///< Maximum number of degrees in a scale (chromatic).
+
+private:
+    /// @brief Pitch-class masks for each ScaleType, in enum order.
+    static constexpr uint16_t SCALE_MASKS[] = {
+        0b101010110101, // Major
+        0b010110101101, // NaturalMinor
+        0b100110101101, // HarmonicMinor
+        0b101010101101, // MelodicMinor (ascending)
+        0b011010101101, // Dorian
+        0b010110101011, // Phrygian
+        0b101011010101, // Lydian
+        0b011010110101, // Mixolydian
+        0b010101101011, // Locrian
+        0b001010010101, // MajorPentatonic
+        0b010010101001, // MinorPentatonic
+        0b010011101001, // Blues
+        0b111111111111  // Chromatic
+    };
+
+    uint16_t mask_;                         ///< Pitch classes in the scale, relative to the root.
+    uint8_t degreeCount_ = 0;               ///< Number of set bits in the mask.
+    int8_t intervals_[MAX_DEGREES] = {};    ///< Semitone offset of each degree above the root.
+};
+
+#endif // SCALE_H
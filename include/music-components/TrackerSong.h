@@ -0,0 +1,202 @@
+/// @file TrackerSong.h
+/// @brief Definition of the TrackerSong class which plays reusable patterns of notes from an order table, in the style of MOD trackers.
+
+#ifndef TRACKER_SONG_H
+#define TRACKER_SONG_H
+
+#include <stdint.h>    // for uint8_t, int8_t, uint16_t
+#include <stddef.h>    // for size_t
+#include "NoteName.h"
+#include "music-components/Note.h"
+
+
+/// @brief Pitch value of a rest step.
+static constexpr uint8_t TRACKER_REST = 0xFF;
+
+/**
+ * @struct TrackerStep
+ * @brief One note or rest of a pattern, in two bytes.
+ */
+struct TrackerStep
+{
+    uint8_t pitch;  ///< Semitones above C0 (octave * 12 + note), or TRACKER_REST.
+    uint8_t rows;   ///< Length in rows of the song's tempo.
+};
+
+/**
+ * @brief Makes a note step.
+ * @param note The pitch class.
+ * @param octave The octave (0–6).
+ * @param rows Length in rows.
+ */
+constexpr TrackerStep trackerNote(NoteName note, int octave, uint8_t rows)
+{
+    return TrackerStep{uint8_t((octave * 12) + int(note)), rows};
+}
+
+/**
+ * @brief Makes a rest step.
+ * @param rows Length in rows.
+ */
+constexpr TrackerStep trackerRest(uint8_t rows)
+{
+    return TrackerStep{TRACKER_REST, rows};
+}
+
+/**
+ * @struct TrackerPattern
+ * @brief A run of steps in the song's step table, stored once however often it is played.
+ */
+struct TrackerPattern
+{
+    uint16_t firstStep;     ///< Index of the pattern's first step.
+    uint8_t stepCount;      ///< Number of steps.
+};
+
+/**
+ * @struct TrackerOrder
+ * @brief One entry of the order table: which pattern to play next, how transposed and how many times.
+ */
+struct TrackerOrder
+{
+    uint8_t pattern;        ///< Index of the pattern.
+    int8_t transpose;       ///< Semitones added to every note (notes pushed out of range become rests).
+    uint8_t repeat;         ///< Number of times to play the pattern (at least 1).
+};
+
+/**
+ * @struct TrackerEvent
+ * @brief A note or rest produced by walking a TrackerSong.
+ */
+struct TrackerEvent
+{
+    Note note;              ///< The note (unused for rests).
+    bool isRest;            ///< True if this is a silence.
+    int durationMs;         ///< Duration in milliseconds.
+};
+
+/**
+ * @struct TrackerMemoryReport
+ * @brief Size of a TrackerSong compared with the same song stored as a flat list of steps.
+ */
+struct TrackerMemoryReport
+{
+    size_t patternBytes;    ///< Bytes of the step, pattern and order tables.
+    size_t flatBytes;       ///< Bytes of the expanded song as one TrackerStep per event.
+    size_t flatEvents;      ///< Number of events in the expanded song.
+    float compressionRatio; ///< flatBytes / patternBytes.
+};
+
+
+/// @class TrackerSong
+/// @brief A song made of short patterns of notes, referenced by an order table with per-entry transpose and repeat.
+///
+/// The song does not own its data: the step, pattern and order tables are usually `constexpr`
+/// arrays, so on a microcontroller they stay in flash, and memory grows with the unique
+/// material rather than the length of the song. Patterns are expanded one event at a time by
+/// TrackerCursor as the song plays.
+///
+/// @code
+/// constexpr TrackerStep steps[] = { trackerNote(NoteName::C, 4, 2), trackerNote(NoteName::E, 4, 2), trackerRest(4) };
+/// constexpr TrackerPattern patterns[] = { {0, 3} };
+/// constexpr TrackerOrder orders[] = { {0, 0, 4}, {0, 5, 2} };
+/// TrackerSong song(steps, 3, patterns, 1, orders, 2, 125);
+/// @endcode
+class TrackerSong
+{
+public:
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+    /// @brief Constructs a song over existing tables (which must outlive it).
+    /// @param steps The steps of every pattern.
+    /// @param stepCount Number of steps.
+    /// @param patterns The patterns, as runs of steps.
+    /// @param patternCount Number of patterns.
+    /// @param orders The order table.
+    /// @param orderCount Number of orders.
+    /// @param rowMs Length of one row in milliseconds (the tempo).
+    TrackerSong(const TrackerStep* steps, int stepCount, const TrackerPattern* patterns, int patternCount,
+                const TrackerOrder* orders, int orderCount, int rowMs);
+
+
+// ----------------------------------------- H E L P E R S -----------------------------------------
+    /// @brief Checks that every order refers to a pattern and every pattern lies within the step table.
+    bool isValid() const;
+
+    /// @brief Compares the size of the song with a flat list of its events.
+    TrackerMemoryReport getMemoryReport() const;
+
+    /// @brief Gets the number of events in the expanded song.
+    size_t getEventCount() const;
+
+    /// @brief Gets the length of the song in milliseconds.
+    long getDurationMs() const;
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+    /// @brief Gets a step.
+    const TrackerStep& getStep(int index) const;
+
+    /// @brief Gets the number of steps.
+    int getStepCount() const;
+
+    /// @brief Gets a pattern.
+    const TrackerPattern& getPattern(int index) const;
+
+    /// @brief Gets an order.
+    const TrackerOrder& getOrder(int index) const;
+
+    /// @brief Gets the number of patterns.
+    int getPatternCount() const;
+
+    /// @brief Gets the number of orders.
+    int getOrderCount() const;
+
+    /// @brief Gets the length of one row in milliseconds.
+    int getRowMs() const;
+
+private:
+    const TrackerStep* steps_;          ///< The steps of every pattern.
+    int stepCount_;                     ///< Number of steps.
+    const TrackerPattern* patterns_;    ///< The patterns.
+    int patternCount_;                  ///< Number of patterns.
+    const TrackerOrder* orders_;        ///< The order table.
+    int orderCount_;                    ///< Number of orders.
+    int rowMs_;                         ///< Length of one row in milliseconds.
+
+    static constexpr int DEFAULT_ROW_MS = 125; ///< Default row length (120 BPM, four rows per beat).
+};
+
+
+/// @class TrackerCursor
+/// @brief Walks a TrackerSong one event at a time, applying the transpose and repeat of each order.
+class TrackerCursor
+{
+public:
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+    /// @brief Constructs a cursor at the start of a song.
+    /// @param song The song to walk (must outlive the cursor).
+    explicit TrackerCursor(const TrackerSong& song);
+
+
+// ----------------------------------------- H E L P E R S -----------------------------------------
+    /// @brief Gets the next event and moves past it.
+    /// @param event Receives the event.
+    /// @return false at the end of the song.
+    bool next(TrackerEvent& event);
+
+    /// @brief Moves back to the start of the song.
+    void reset();
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+    /// @brief Gets the index of the order being played.
+    int getOrderIndex() const;
+
+private:
+    const TrackerSong& song_;   ///< The song being walked.
+    int order_ = 0;             ///< Index of the current order.
+    int pass_ = 0;              ///< Repeat of the current order being played.
+    int step_ = 0;              ///< Step within the current pattern.
+};
+
+#endif // TRACKER_SONG_H
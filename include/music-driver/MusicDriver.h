@@ -5,12 +5,14 @@
 #define MUSIC_DRIVER_H
 
 #include "tone-driver/ToneDriver.h" 
+#include "tone-driver/StaticToneDriver.h"
 #include "music-components/Note.h"
 //#include "music-components/NoteEvent.h"
-//#include "music-components/Chord.h"
-//#include "music-components/ChordEvent.h"
-//#include "music-components/Key.h"
-//#include "music-components/Scale.h"
+#include "music-components/Chord.h"
+#include "music-components/ChordEvent.h"
+#include "music-components/Key.h"
+#include "music-components/Scale.h"
+#include "music-components/TrackerSong.h"
  
 /**
  * @brief Plays a Note object via a ToneDriver for a given duration.
@@ -23,11 +25,131 @@ void playNote(ToneDriver &driver, Note &note, int durationMs);
 
 //void playNoteEvent(ToneDriver &driver, NoteEvent &noteEvent);
 
-//void playChord(ToneDriver &driver, Chord &chord, int durationMs);
-//void playChordEvent(ToneDriver &driver, ChordEvent &chordEvent);
+/**
+ * @brief Plays a Chord object via a ToneDriver for a given duration.
+ * 
+ * The chord is voiced in root position and handed to the driver in a single call.
+ * 
+ * @param driver The ToneDriver object to use to play the chord.
+ * @param chord A Chord object which represents the chord to be played.
+ * @param durationMs How long to play the chord for (in ms). 
+ */
+void playChord(ToneDriver &driver, Chord &chord, int durationMs);
+
+/**
+ * @brief Plays a ChordEvent object via a ToneDriver, using its voicing and duration.
+ * 
+ * @param driver The ToneDriver object to use to play the chord.
+ * @param chordEvent A ChordEvent object which represents the chord, voicing and duration.
+ */
+void playChordEvent(ToneDriver &driver, ChordEvent &chordEvent);
 
 //void playArpeggio(ToneDriver &driver, Chord &chord, int totalDurationMs);
 
-//void playScale(ToneDriver &driver, Key &key, int octaves);
+/**
+ * @brief Plays a scale up and back down via a ToneDriver.
+ * 
+ * The whole run is built up front and submitted to the driver in a single playSequence() call,
+ * so the driver can schedule every note rather than being woken for each one.
+ * 
+ * @param driver The ToneDriver object to use to play the scale.
+ * @param key The Key to take the notes of the scale from.
+ * @param startOctave The octave of the first (root) note.
+ * @param octaves How many octaves to ascend before descending again.
+ * @param noteDurationMs How long to play each note for (in ms).
+ * @param restMs How long to rest after each note (in ms).
+ */
+void playScale(ToneDriver &driver, Key &key, uint8_t startOctave, int octaves, int noteDurationMs, int restMs);
+
+/**
+ * @brief Plays a TrackerSong via a ToneDriver, expanding its patterns one event at a time.
+ * 
+ * Plays nothing if the song is not valid (see TrackerSong::isValid()).
+ * 
+ * @param driver The ToneDriver object to use to play the song.
+ * @param song The song to play.
+ */
+void playTrackerSong(ToneDriver &driver, const TrackerSong &song);
+
+static constexpr int MAX_SCALE_NOTES = (2 * Scale::MAX_DEGREES * (Note::MAX_OCTAVE + 1)) + 1; ///< Longest possible up-and-down run
+
+/**
+ * @brief Builds the notes of a scale run up and back down, as played by playScale().
+ * 
+ * @param key The Key to take the notes of the scale from.
+ * @param startOctave The octave of the first (root) note.
+ * @param octaves How many octaves to ascend before descending again.
+ * @param notes Receives up to MAX_SCALE_NOTES pitch classes.
+ * @param noteOctaves Receives the octave of each note.
+ * @return The number of notes, or 0 if the run is empty, too long, or would climb above octave 6.
+ */
+int getScaleRun(Key &key, uint8_t startOctave, int octaves, NoteName notes[MAX_SCALE_NOTES], int noteOctaves[MAX_SCALE_NOTES]);
+
+
+// ------------------------- S T A T I C   D I S P A T C H -------------------------
+// The same functions for StaticToneDriver backends. Every driver call is made on the backend
+// type, so it can be inlined with no vtable.
+
+/** @copydoc playNote(ToneDriver&, Note&, int) */
+template <typename Backend>
+void playNote(StaticToneDriver<Backend> &driver, Note &note, int durationMs)
+{
+    static_cast<Backend&>(driver).playNote(note.getNoteName(), note.getOctave(), durationMs);
+}
+
+/** @copydoc playChord(ToneDriver&, Chord&, int) */
+template <typename Backend>
+void playChord(StaticToneDriver<Backend> &driver, Chord &chord, int durationMs)
+{
+    ChordVoicing voicing = chord.getVoicing();
+    static_cast<Backend&>(driver).playChord(voicing.notes, voicing.octaves, voicing.count, durationMs);
+}
+
+/** @copydoc playChordEvent(ToneDriver&, ChordEvent&) */
+template <typename Backend>
+void playChordEvent(StaticToneDriver<Backend> &driver, ChordEvent &chordEvent)
+{
+    ChordVoicing voicing = chordEvent.getVoicing();
+    static_cast<Backend&>(driver).playChord(voicing.notes, voicing.octaves, voicing.count, chordEvent.getDurationMs());
+}
+
+/** @copydoc playScale(ToneDriver&, Key&, uint8_t, int, int, int) */
+template <typename Backend>
+void playScale(StaticToneDriver<Backend> &driver, Key &key, uint8_t startOctave, int octaves, int noteDurationMs, int restMs)
+{
+    NoteName notes[MAX_SCALE_NOTES];
+    int noteOctaves[MAX_SCALE_NOTES];
+
+    int count = getScaleRun(key, startOctave, octaves, notes, noteOctaves);
+    if (count > 0)
+    {
+        static_cast<Backend&>(driver).playSequence(notes, noteOctaves, count, noteDurationMs, restMs);
+    }
+}
+
+/** @copydoc playTrackerSong(ToneDriver&, const TrackerSong&) */
+template <typename Backend>
+void playTrackerSong(StaticToneDriver<Backend> &driver, const TrackerSong &song)
+{
+    if (!song.isValid())
+    {
+        return;
+    }
+
+    TrackerCursor cursor(song);
+    TrackerEvent event;
+
+    while (cursor.next(event))
+    {
+        if (event.isRest)
+        {
+            static_cast<Backend&>(driver).rest(event.durationMs);
+        }
+        else
+        {
+            static_cast<Backend&>(driver).playNote(event.note.getNoteName(), event.note.getOctave(), event.durationMs);
+        }
+    }
+}
 
 #endif // MUSIC_DRIVER_H
\ No newline at end of file
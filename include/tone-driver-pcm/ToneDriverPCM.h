@@ -0,0 +1,279 @@
+/// @file ToneDriverPCM.h
+/// @brief Definition of the raw PCM streaming implementation of the ToneDriver interface.
+
+#ifndef TONE_DRIVER_PCM_H
+#define TONE_DRIVER_PCM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "tone-driver/ToneDriver.h"
+#include "tone-driver/ToneDriverDiagnostics.h"
+#include "tone-synth/Voice.h"
+
+/**
+ * @enum PcmSampleFormat
+ * @brief Sample encoding written to the stream (native byte order, i.e. little-endian on x86 and ARM).
+ */
+enum class PcmSampleFormat {
+    S16,    ///< Signed 16-bit integer (ffmpeg: s16le).
+    S32,    ///< Signed 32-bit integer (ffmpeg: s32le).
+    F32     ///< 32-bit float from -1.0 to 1.0 (ffmpeg: f32le).
+};
+
+/**
+ * @enum PcmPacing
+ * @brief How fast samples are produced.
+ */
+enum class PcmPacing {
+    Unpaced,    ///< Render as fast as the consumer accepts; timed calls return as soon as their samples are queued.
+    RealTime    ///< Follow the wall clock like a sound card: gaps between calls become silence and timed calls block.
+};
+
+/**
+ * @struct PcmStreamConfig
+ * @brief Format and buffering of a ToneDriverPCM stream.
+ */
+struct PcmStreamConfig
+{
+    int sampleRate = 44100;                         ///< Sample rate in Hz.
+    int channels = 1;                               ///< Number of interleaved channels (the tone is copied to each).
+    PcmSampleFormat format = PcmSampleFormat::S16;  ///< Sample encoding.
+    PcmPacing pacing = PcmPacing::Unpaced;          ///< Paced or unpaced rendering.
+    int blockFrames = 8192;                         ///< Frames per write; the writer holds two blocks.
+};
+
+
+/**
+ * @class ToneDriverPCM
+ * @brief ToneDriver implementation that streams rendered PCM to a file descriptor.
+ *
+ * Instead of a sound card, samples are written to stdout, a pipe or a file so they can be
+ * fed to an encoder, for example:
+ *
+ * @code
+ * ./game | ffmpeg -f s16le -ar 44100 -ac 1 -i pipe:0 audio.wav
+ * @endcode
+ *
+ * Tones are rendered on the calling thread into one of two blocks while a writer thread
+ * writes the other with a few large write() calls. If the consumer is slow the renderer waits
+ * for the writer to hand a block back, so backpressure is bounded to one block and shows up
+ * in getBlockedMs() rather than as unbounded buffering.
+ *
+ * In Unpaced mode the stream is a timeline advanced only by timed calls (notes with a
+ * duration, rests, stopAfter() and advance()). In RealTime mode wall-clock time between
+ * calls is rendered too, so an untimed playNote() followed by a sleep and stop() works as it
+ * does with ToneDriverSDL2.
+ */
+class ToneDriverPCM : public ToneDriver
+{
+public:
+    /**
+     * @brief Constructor. Starts the writer thread.
+     *
+     * @param fd     File descriptor to write to (1 for stdout). Not closed by the driver.
+     * @param config Format, pacing and block size of the stream.
+     */
+    explicit ToneDriverPCM(int fd = 1, const PcmStreamConfig& config = PcmStreamConfig());
+
+    /** @copydoc ToneDriver::playFrequency(float) */
+    void playFrequency(float freq) override;
+
+    /** @copydoc ToneDriver::playFrequency(float, int) */
+    void playFrequency(float freq, int durationMs) override;
+
+    /** @copydoc ToneDriver::playNote(NoteName, int) */
+    void playNote(NoteName note, int octave) override;
+
+    /** @copydoc ToneDriver::playNote(NoteName, int, int) */
+    void playNote(NoteName note, int octave, int durationMs) override;
+
+    /** @copydoc ToneDriver::playChord */
+    void playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count) override;
+
+    /**
+     * @copydoc ToneDriver::playChord(const NoteName[], const int[], int, int)
+     * @details Rendered as a cycling arpeggio of DEFAULT_CHORD_ARPEGGIO_DELAY_MS steps, as ToneDriverSDL2 plays it.
+     */
+    void playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int durationMs) override;
+
+    /** @copydoc ToneDriver::playArpeggio */
+    void playArpeggio(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int noteDurationMs = DEFAULT_NOTE_DURATION_MS, int delayMs = DEFAULT_ARPEGGIO_DELAY_MS) override;
+
+    /** @copydoc ToneDriver::playSequence */
+    void playSequence(const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs) override;
+
+    /** @copydoc ToneDriver::stop */
+    void stop() override;
+
+    /** @copydoc ToneDriver::stopAfter */
+    void stopAfter(int durationMs) override;
+
+    /** @copydoc ToneDriver::rest */
+    void rest(int durationMs) override;
+
+    /**
+     * @brief Render the current tone (or silence) for a duration without changing it.
+     *
+     * @param durationMs Duration in milliseconds.
+     */
+    void advance(int durationMs);
+
+    /**
+     * @brief Set the output amplitude of the tone.
+     *
+     * @param amplitude Value from 0.0 to 1.0 representing volume.
+     */
+    void setAmplitude(float amplitude);
+
+    /**
+     * @brief Write everything rendered so far and wait until it has been written.
+     */
+    void flush();
+
+    /** @copydoc ToneDriver::isValidNote */
+    bool isValidNote(NoteName note, int octave) override;
+
+    /**
+     * @brief Error counters and the rate-limited error log for this driver.
+     *
+     * Logged errors are printed to std::cerr after each blocking call and when the driver is
+     * destroyed; see ToneDriverDiagnostics::setOutput().
+     *
+     * @return The driver's diagnostics.
+     */
+    ToneDriverDiagnostics& getDiagnostics();
+
+    /**
+     * @brief Gets the number of frames written to the file descriptor so far.
+     *
+     * @return Frames written (one sample per channel each).
+     */
+    uint64_t getFramesWritten() const;
+
+    /**
+     * @brief Total time the renderer has waited for a slow consumer.
+     *
+     * @return Time blocked on backpressure in milliseconds.
+     */
+    float getBlockedMs() const;
+
+    /**
+     * @brief Check whether a write to the file descriptor has failed (e.g. the consumer exited).
+     *
+     * The failure is also logged to getDiagnostics() as DiagnosticCode::WriteFailed.
+     *
+     * @return true if output has been discarded since a failed write.
+     */
+    bool hasWriteError() const;
+
+    /** @brief Destructor. Flushes the stream and stops the writer thread. */
+    ~ToneDriverPCM();
+
+private:
+    /**
+     * @brief Renders the current tone for a number of frames into the active block.
+     *
+     * @param frames Number of frames to render.
+     */
+    void render(uint64_t frames);
+
+    /**
+     * @brief Renders a timed tone or rest, then paces and submits it.
+     *
+     * @param frequency Frequency in Hertz, or 0 for silence.
+     * @param durationMs Duration in milliseconds.
+     */
+    void renderStep(float frequency, int durationMs);
+
+    /**
+     * @brief Starts a tone, or silence if the frequency is 0.
+     *
+     * @param frequency Frequency in Hertz.
+     */
+    void startTone(float frequency);
+
+    /**
+     * @brief In RealTime mode, renders the time that has passed since the last call.
+     */
+    void catchUp();
+
+    /**
+     * @brief In RealTime mode, submits what has been rendered and sleeps until the wall clock reaches it.
+     */
+    void pace();
+
+    /**
+     * @brief Hands the active block to the writer, waiting if the writer still has the other one.
+     */
+    void submitBlock();
+
+    /**
+     * @brief Writer thread: writes each submitted block to the file descriptor.
+     */
+    void writerLoop();
+
+    /**
+     * @brief Writes a whole buffer, retrying short writes.
+     *
+     * @param data  Bytes to write.
+     * @param bytes Number of bytes.
+     * @return false if the write failed.
+     */
+    bool writeAll(const uint8_t* data, size_t bytes);
+
+    /**
+     * @brief Converts milliseconds to frames at the stream's sample rate.
+     */
+    uint64_t msToFrames(int durationMs) const;
+
+    /**
+     * @brief Calculates the frequency of a note.
+     */
+    static float getNoteFrequency(NoteName note, int octave);
+
+    /**
+     * @brief Checks that a chord or arpeggio has between 1 and MAX_POLYPHONY notes, reporting it if not.
+     */
+    bool isValidNoteCount(int count);
+
+    int fd;                                     ///< File descriptor samples are written to.
+    PcmStreamConfig config;                     ///< Stream format, pacing and block size.
+    size_t bytesPerFrame;                       ///< Bytes in one frame (all channels).
+
+    Voice voice;                                ///< Oscillator for the current tone.
+    bool toneOn = false;                        ///< True while a tone is sounding.
+    float amplitude = 0.85f;                    ///< Output amplitude (0.0 to 1.0).
+    uint64_t framesRendered = 0;                ///< Frames rendered since the stream started.
+
+    std::vector<uint8_t> blocks[2];             ///< Double buffer: one being rendered, one being written.
+    int activeBlock = 0;                        ///< Index of the block being rendered into.
+    size_t activeBytes = 0;                     ///< Bytes rendered into the active block.
+
+    std::thread writerThread;                   ///< Writes submitted blocks.
+    std::mutex writerMutex;                     ///< Guards the hand-off to the writer.
+    std::condition_variable writerCondition;    ///< Signals a submitted or completed block.
+    bool blockPending = false;                  ///< True while the writer holds a block.
+    int pendingBlock = 0;                       ///< Index of the block the writer holds.
+    size_t pendingBytes = 0;                    ///< Bytes in the block the writer holds.
+    bool stopping = false;                      ///< Tells the writer to exit once idle.
+
+    std::atomic<uint64_t> framesWritten{0};     ///< Frames written to the file descriptor.
+    std::atomic<uint64_t> blockedMicros{0};     ///< Time spent waiting for the writer, in microseconds.
+    std::atomic<bool> writeError{false};        ///< True once a write has failed.
+
+    std::chrono::steady_clock::time_point streamStart; ///< Wall-clock time of frame 0 (RealTime mode).
+
+    ToneDriverDiagnostics diagnostics;          ///< Counts invalid play calls without doing I/O.
+
+    const static int REF_FREQ;                  ///< Reference frequency in Hz (A4 = 440Hz).
+    const static NoteName REF_NOTE;             ///< Reference note (A).
+    const static int REF_OCTAVE;                ///< Reference octave (4).
+};
+
+#endif // TONE_DRIVER_PCM_H
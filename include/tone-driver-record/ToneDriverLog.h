@@ -0,0 +1,70 @@
+/// @file ToneDriverLog.h
+/// @brief Definition of the binary log format written by ToneDriverRecorder and read by ToneDriverReplayer.
+
+#ifndef TONE_DRIVER_LOG_H
+#define TONE_DRIVER_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @enum ToneDriverCall
+ * @brief Opcode of each ToneDriver call in a log.
+ *
+ * A log is the 4-byte magic "TDRL" and a version byte, then one record per call:
+ *
+ * | Field     | Encoding                                                          |
+ * |-----------|-------------------------------------------------------------------|
+ * | opcode    | 1 byte (ToneDriverCall)                                           |
+ * | time      | unsigned varint: microseconds since the previous call started      |
+ * | arguments | frequencies as 4-byte little-endian floats, notes as 1 byte, other |
+ * |           | integers as zigzag varints, arrays as a count then their elements  |
+ *
+ * A typical timed note is 5 or 6 bytes.
+ */
+enum class ToneDriverCall : uint8_t {
+    PlayFrequency = 1,      ///< playFrequency(freq)
+    PlayFrequencyFor,       ///< playFrequency(freq, durationMs)
+    PlayNote,               ///< playNote(note, octave)
+    PlayNoteFor,            ///< playNote(note, octave, durationMs)
+    PlayChord,              ///< playChord(notes, octaves, count)
+    PlayChordFor,           ///< playChord(notes, octaves, count, durationMs)
+    PlayArpeggio,           ///< playArpeggio(notes, octaves, count, noteDurationMs, delayMs)
+    PlaySequence,           ///< playSequence(notes, octaves, count, noteDurationMs, restMs)
+    Stop,                   ///< stop()
+    StopAfter,              ///< stopAfter(durationMs)
+    Rest,                   ///< rest(durationMs)
+    IsValidNote             ///< isValidNote(note, octave)
+};
+
+static constexpr char TONE_DRIVER_LOG_MAGIC[4] = {'T', 'D', 'R', 'L'};  ///< First bytes of every log.
+static constexpr uint8_t TONE_DRIVER_LOG_VERSION = 1;                   ///< Format version written after the magic.
+static constexpr int TONE_DRIVER_LOG_MAX_NOTES = 4096;                  ///< Longest note array a log may hold.
+
+/**
+ * @brief Gets the name of a call (e.g. "playNote").
+ *
+ * @param call The call.
+ * @return The call's name, or "unknown".
+ */
+constexpr const char* toneDriverCallToString(ToneDriverCall call)
+{
+    switch (call)
+    {
+        case ToneDriverCall::PlayFrequency:
+        case ToneDriverCall::PlayFrequencyFor:  return "playFrequency";
+        case ToneDriverCall::PlayNote:
+        case ToneDriverCall::PlayNoteFor:       return "playNote";
+        case ToneDriverCall::PlayChord:
+        case ToneDriverCall::PlayChordFor:      return "playChord";
+        case ToneDriverCall::PlayArpeggio:      return "playArpeggio";
+        case ToneDriverCall::PlaySequence:      return "playSequence";
+        case ToneDriverCall::Stop:              return "stop";
+        case ToneDriverCall::StopAfter:         return "stopAfter";
+        case ToneDriverCall::Rest:              return "rest";
+        case ToneDriverCall::IsValidNote:       return "isValidNote";
+    }
+    return "unknown";
+}
+
+#endif // TONE_DRIVER_LOG_H
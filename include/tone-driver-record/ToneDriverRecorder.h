@@ -0,0 +1,122 @@
+/// @file ToneDriverRecorder.h
+/// @brief Definition of the ToneDriverRecorder class which logs every call made to another ToneDriver.
+
+#ifndef TONE_DRIVER_RECORDER_H
+#define TONE_DRIVER_RECORDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <chrono>
+#include <ostream>
+#include <vector>
+#include "tone-driver/ToneDriver.h"
+#include "tone-driver-record/ToneDriverLog.h"
+
+/**
+ * @class ToneDriverRecorder
+ * @brief ToneDriver decorator that forwards every call to another driver and records it in a compact binary log.
+ *
+ * Each call is logged with its arguments and the time since the previous call (see
+ * ToneDriverLog.h for the format) before it is forwarded, so a log captured in the field can
+ * be replayed later with ToneDriverReplayer. Records are built in a memory buffer that is
+ * reserved up front and written to the stream only when it fills, on flush() or on
+ * destruction, so recording costs a few stores per call and no I/O on the calling thread in
+ * between.
+ */
+class ToneDriverRecorder : public ToneDriver
+{
+public:
+    /**
+     * @brief Constructor. Writes the log header.
+     *
+     * @param target      Driver to forward calls to (must outlive the recorder).
+     * @param log         Stream to write the log to, opened in binary mode (must outlive the recorder).
+     * @param bufferBytes Bytes of log kept in memory between writes.
+     */
+    ToneDriverRecorder(ToneDriver& target, std::ostream& log, size_t bufferBytes = DEFAULT_BUFFER_BYTES);
+
+    /** @copydoc ToneDriver::playFrequency(float) */
+    void playFrequency(float freq) override;
+
+    /** @copydoc ToneDriver::playFrequency(float, int) */
+    void playFrequency(float freq, int durationMs) override;
+
+    /** @copydoc ToneDriver::playNote(NoteName, int) */
+    void playNote(NoteName note, int octave) override;
+
+    /** @copydoc ToneDriver::playNote(NoteName, int, int) */
+    void playNote(NoteName note, int octave, int durationMs) override;
+
+    /** @copydoc ToneDriver::playChord(const NoteName[], const int[], int) */
+    void playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count) override;
+
+    /** @copydoc ToneDriver::playChord(const NoteName[], const int[], int, int) */
+    void playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int durationMs) override;
+
+    /** @copydoc ToneDriver::playArpeggio */
+    void playArpeggio(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int noteDurationMs = DEFAULT_NOTE_DURATION_MS, int delayMs = DEFAULT_ARPEGGIO_DELAY_MS) override;
+
+    /** @copydoc ToneDriver::playSequence */
+    void playSequence(const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs) override;
+
+    /** @copydoc ToneDriver::stop */
+    void stop() override;
+
+    /** @copydoc ToneDriver::stopAfter */
+    void stopAfter(int durationMs) override;
+
+    /** @copydoc ToneDriver::rest */
+    void rest(int durationMs) override;
+
+    /** @copydoc ToneDriver::isValidNote */
+    bool isValidNote(NoteName note, int octave) override;
+
+    /**
+     * @brief Writes the buffered records to the stream.
+     */
+    void flush();
+
+    /** @brief Gets the number of calls recorded. */
+    uint64_t getCallCount() const;
+
+    /** @brief Gets the size of the log so far in bytes, including the header. */
+    uint64_t getLogBytes() const;
+
+    /** @brief Destructor. Writes any buffered records. */
+    ~ToneDriverRecorder();
+
+    static constexpr size_t DEFAULT_BUFFER_BYTES = 64 * 1024; ///< Default log buffer size.
+
+private:
+    /**
+     * @brief Starts a record: the opcode and the time since the previous call.
+     */
+    void beginRecord(ToneDriverCall call);
+
+    /**
+     * @brief Ends a record, writing the buffer out if it is nearly full.
+     */
+    void endRecord();
+
+    /** @brief Appends an unsigned varint. */
+    void writeUnsigned(uint64_t value);
+
+    /** @brief Appends a zigzag-encoded signed varint. */
+    void writeSigned(int64_t value);
+
+    /** @brief Appends a float as 4 little-endian bytes. */
+    void writeFloat(float value);
+
+    /** @brief Appends a count followed by that many notes and octaves. */
+    void writeNotes(const NoteName notes[], const int octaves[], int count);
+
+    ToneDriver& target;                     ///< Driver calls are forwarded to.
+    std::ostream& log;                      ///< Stream the log is written to.
+    std::vector<uint8_t> buffer;            ///< Records not yet written.
+    size_t flushThreshold;                  ///< Buffer size that triggers a write.
+    std::chrono::steady_clock::time_point lastCall; ///< Start of the previous call.
+    uint64_t callCount = 0;                 ///< Calls recorded.
+    uint64_t bytesWritten = 0;              ///< Bytes written to the stream.
+};
+
+#endif // TONE_DRIVER_RECORDER_H
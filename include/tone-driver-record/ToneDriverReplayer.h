@@ -0,0 +1,100 @@
+/// @file ToneDriverReplayer.h
+/// @brief Definition of the ToneDriverReplayer class which re-drives a ToneDriver from a recorded log.
+
+#ifndef TONE_DRIVER_REPLAYER_H
+#define TONE_DRIVER_REPLAYER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <istream>
+#include <vector>
+#include "NoteName.h"
+#include "tone-driver/ToneDriver.h"
+#include "tone-driver-record/ToneDriverLog.h"
+
+/**
+ * @enum ReplayPacing
+ * @brief When each recorded call is made.
+ */
+enum class ReplayPacing {
+    RealTime,   ///< At its recorded time since the start of the log (calls the backend makes late are reported).
+    Unpaced     ///< As soon as the previous call returns (for offline rendering and profiling).
+};
+
+/**
+ * @struct ReplayReport
+ * @brief The result of replaying a log.
+ */
+struct ReplayReport
+{
+    bool ok = false;                ///< False if the log was truncated or corrupt (calls before the error were replayed).
+    size_t errorOffset = 0;         ///< Byte offset of the bad record.
+    uint64_t calls = 0;             ///< Calls replayed.
+    uint64_t callCounts[16] = {};   ///< Calls replayed by opcode (indexed by ToneDriverCall).
+    float recordedMs = 0.0f;        ///< Time from the first to the last call when recorded.
+    float replayMs = 0.0f;          ///< Time taken to replay every call.
+    float maxLateMs = 0.0f;         ///< Worst delay of a call behind its recorded time (RealTime pacing).
+    float maxCallMs = 0.0f;         ///< Longest time the backend took to return from a call.
+    size_t slowestCall = 0;         ///< Index of the call that took maxCallMs.
+};
+
+/**
+ * @class ToneDriverReplayer
+ * @brief Reads a log written by ToneDriverRecorder and makes the same calls on any ToneDriver.
+ *
+ * The whole log is read into memory by the constructor, so replay does no I/O.
+ */
+class ToneDriverReplayer
+{
+public:
+    /**
+     * @brief Constructor. Reads the whole log.
+     *
+     * @param log Stream to read the log from, opened in binary mode.
+     */
+    explicit ToneDriverReplayer(std::istream& log);
+
+    /**
+     * @brief Checks the log header.
+     *
+     * @return false if the stream is not a log or is a newer version.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Replays the log.
+     *
+     * @param target Driver to make the calls on.
+     * @param pacing When to make each call.
+     * @return What was replayed and how long the backend took.
+     */
+    ReplayReport replay(ToneDriver& target, ReplayPacing pacing = ReplayPacing::RealTime);
+
+private:
+    /** @brief Reads an unsigned varint, clearing ok on truncation. */
+    uint64_t readUnsigned();
+
+    /** @brief Reads a zigzag-encoded signed varint as an int. */
+    int readSigned();
+
+    /** @brief Reads a 4-byte little-endian float. */
+    float readFloat();
+
+    /** @brief Reads a byte. */
+    uint8_t readByte();
+
+    /**
+     * @brief Reads a count and that many notes and octaves.
+     *
+     * @return The recorded count (the arrays hold at most TONE_DRIVER_LOG_MAX_NOTES).
+     */
+    int readNotes();
+
+    std::vector<uint8_t> data;      ///< The whole log.
+    size_t position = 0;            ///< Next byte to read.
+    bool readOk = true;             ///< False once a read has run past the end.
+    std::vector<NoteName> notes;    ///< Note array of the current call.
+    std::vector<int> octaves;       ///< Octave array of the current call.
+};
+
+#endif // TONE_DRIVER_REPLAYER_H
@@ -0,0 +1,68 @@
+/// @file AudioThread.h
+/// @brief Scheduling priority and CPU affinity settings for the thread that runs the audio callback.
+
+#ifndef AUDIO_THREAD_H
+#define AUDIO_THREAD_H
+
+#include <stdint.h>
+
+/**
+ * @enum AudioThreadPriority
+ * @brief Scheduling priority for the audio thread.
+ */
+enum class AudioThreadPriority {
+    Normal,     ///< Default scheduling, shared fairly with every other thread.
+    High,       ///< Raised priority within normal scheduling (e.g. a negative nice value on Linux).
+    Realtime    ///< Real-time scheduling (e.g. SCHED_FIFO on Linux, time critical on Windows).
+};
+
+/**
+ * @brief Converts an AudioThreadPriority to a const char* string literal.
+ *
+ * @param priority The AudioThreadPriority value.
+ * @return A pointer to a string literal naming the priority.
+ */
+inline const char* audioThreadPriorityToString(AudioThreadPriority priority) {
+    switch (priority) {
+        case AudioThreadPriority::Normal:   return "Normal";
+        case AudioThreadPriority::High:     return "High";
+        case AudioThreadPriority::Realtime: return "Realtime";
+        default:                            return "?";
+    }
+}
+
+
+/**
+ * @struct AudioThreadOptions
+ * @brief Requested scheduling for the audio thread.
+ */
+struct AudioThreadOptions
+{
+    AudioThreadPriority priority = AudioThreadPriority::Normal; ///< Priority to try for.
+    uint64_t cpuMask = 0;   ///< CPUs the thread may run on (bit n = CPU n), or 0 to leave the affinity alone.
+};
+
+/**
+ * @struct AudioThreadStatus
+ * @brief Scheduling that was actually achieved for the audio thread.
+ */
+struct AudioThreadStatus
+{
+    bool applied = false;                                       ///< True once the options have been applied by the audio thread.
+    AudioThreadPriority priority = AudioThreadPriority::Normal; ///< Priority obtained (may be lower than requested).
+    uint64_t cpuMask = 0;   ///< CPUs the thread may run on, or 0 if unknown or unsupported on this platform.
+};
+
+/**
+ * @brief Applies scheduling options to the calling thread, falling back to lower priorities.
+ *
+ * Realtime falls back to High, and High to Normal, when the process lacks permission
+ * (e.g. no CAP_SYS_NICE or RLIMIT_RTPRIO on Linux). A CPU mask that cannot be applied
+ * leaves the affinity unchanged. Never allocates, so it can be called from an audio callback.
+ *
+ * @param options The requested priority and CPU mask.
+ * @return The priority and CPU mask actually in effect.
+ */
+AudioThreadStatus applyAudioThreadOptions(const AudioThreadOptions& options);
+
+#endif // AUDIO_THREAD_H
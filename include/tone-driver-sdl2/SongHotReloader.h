@@ -0,0 +1,151 @@
+/// @file SongHotReloader.h
+/// @brief Definition of the SongHotReloader class which plays a song file on a loop and re-renders it when the file changes.
+
+#ifndef SONG_HOT_RELOADER_H
+#define SONG_HOT_RELOADER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include "tone-synth/SongFile.h"
+
+/**
+ * @struct SongReloadReport
+ * @brief What happened when a song file was reloaded, and how long the change took to be heard.
+ */
+struct SongReloadReport
+{
+    bool ok = false;                ///< False if the file could not be read or parsed (the old song keeps playing).
+    int errorLine = 0;              ///< First invalid line if parsing failed (0 if the file could not be opened).
+    size_t noteCount = 0;           ///< Notes and rests in the new song.
+    size_t firstChangedNote = 0;    ///< Index of the first note that differs from the old song.
+    size_t changedNotes = 0;        ///< Notes re-rendered (the rest were copied).
+    size_t samplesRendered = 0;     ///< Samples synthesised for the changed notes.
+    size_t samplesCopied = 0;       ///< Samples reused from the old render.
+    float parseMs = 0.0f;           ///< Time to read and parse the file.
+    float renderMs = 0.0f;          ///< Time to diff, render and copy.
+    float saveToQueuedMs = -1.0f;   ///< From the file being saved to the new song being queued for playback.
+    float saveToAudibleMs = -1.0f;  ///< From the file being saved to the first sample of the new song being played.
+};
+
+/**
+ * @class SongHotReloader
+ * @brief Plays a song file on a loop through ToneDriverSDL2 and hot-reloads it when it is saved.
+ *
+ * The song (see parseSong() for the format) is rendered to PCM and fed to a bus a chunk at a
+ * time, a little ahead of playback. update() polls the file; when it changes, only the notes
+ * between the unchanged start and unchanged end of the song are re-rendered, the rest are
+ * copied from the previous render, and feeding carries on from the same place in the new
+ * buffer. Playback never stops, and the old buffer is freed once its queued chunks have played.
+ *
+ * Everything runs on the thread that calls update(), typically once per game frame.
+ */
+class SongHotReloader
+{
+public:
+    /**
+     * @brief Constructor. Nothing is loaded until load() is called.
+     *
+     * @param driver    Driver to play the song on.
+     * @param path      Song file to play and watch.
+     * @param bus       Bus to play the song on.
+     * @param amplitude Peak level of the rendered square wave (0 to 32767).
+     */
+    SongHotReloader(ToneDriverSDL2& driver, const std::string& path, AudioBus bus = AudioBus::Music, int amplitude = DEFAULT_AMPLITUDE);
+
+    /**
+     * @brief Loads and renders the song and starts playing it.
+     *
+     * @return false if the file could not be read or parsed (see getLastReport()).
+     */
+    bool load();
+
+    /**
+     * @brief Keeps playback fed and reloads the song if the file has changed. Call regularly (e.g. every frame).
+     *
+     * Must be called more often than LOOKAHEAD_SAMPLES lasts (about 190 ms) to avoid gaps.
+     */
+    void update();
+
+    /**
+     * @brief Gets a reload report once it is complete (the change has been heard, or the reload failed).
+     *
+     * @param report Receives the report.
+     * @return true once per reload.
+     */
+    bool pollReport(SongReloadReport& report);
+
+    /** @brief Gets the most recent reload report, complete or not. */
+    const SongReloadReport& getLastReport() const;
+
+    /** @brief Gets the number of successful reloads since load(). */
+    int getReloadCount() const;
+
+    /** @brief Stops feeding the song (already queued chunks still play). */
+    void stop();
+
+    /** @brief Destructor. Drops the song's queued chunks before freeing the samples they point to. */
+    ~SongHotReloader();
+
+    static constexpr int DEFAULT_AMPLITUDE = 16384;     ///< Default peak level of the rendered song.
+    static constexpr int POLL_INTERVAL_MS = 50;         ///< How often the file is checked for changes.
+    static constexpr size_t CHUNK_SAMPLES = 2048;       ///< Samples queued per step.
+    static constexpr size_t LOOKAHEAD_SAMPLES = 8192;   ///< Samples kept queued ahead of playback.
+
+private:
+    /**
+     * @brief A previous render still referenced by queued chunks.
+     */
+    struct RetiredBuffer
+    {
+        std::vector<int16_t> pcm;   ///< The samples.
+        Uint64 releaseAt;           ///< Bus rendered count after which no queued chunk uses them.
+    };
+
+    /**
+     * @brief Reads the file and re-renders whatever changed.
+     *
+     * @return false if the file could not be read or parsed.
+     */
+    bool reload();
+
+    /**
+     * @brief Queues chunks until LOOKAHEAD_SAMPLES are waiting on the bus.
+     */
+    void feed();
+
+    /**
+     * @brief Gets the sample offset of every note, plus the total length at the end.
+     *
+     * @param song The song.
+     * @return song.size() + 1 offsets.
+     */
+    std::vector<size_t> getNoteOffsets(const std::vector<SongNote>& song) const;
+
+    ToneDriverSDL2& driver;                     ///< Driver the song is played on.
+    std::string path;                           ///< Song file.
+    AudioBus bus;                               ///< Bus the song is played on.
+    int amplitude;                              ///< Peak level of the rendered square wave.
+
+    std::vector<SongNote> notes;                ///< The song as last loaded.
+    std::vector<size_t> offsets;                ///< Sample offset of each note, plus the total length.
+    std::vector<int16_t> pcm;                   ///< The rendered song being fed.
+    std::vector<RetiredBuffer> retired;         ///< Previous renders waiting for their chunks to play.
+    size_t position = 0;                        ///< Next sample of pcm to queue.
+    bool playing = false;                       ///< True while the song is being fed.
+
+    std::filesystem::file_time_type lastWriteTime; ///< Modification time of the file as last loaded.
+    std::chrono::steady_clock::time_point lastPoll; ///< When the file was last checked.
+
+    SongReloadReport report;                    ///< The most recent reload.
+    bool reportPending = false;                 ///< True until the report has been polled.
+    Uint64 audibleAt = 0;                       ///< Bus queued count at the first chunk of the new song.
+    std::chrono::steady_clock::time_point savedAt; ///< When the file was saved (on the steady clock).
+    int reloadCount = 0;                        ///< Number of successful reloads.
+};
+
+#endif // SONG_HOT_RELOADER_H
@@ -0,0 +1,80 @@
+/// @file SpscQueue.h
+/// @brief Definition of a fixed-capacity single-producer single-consumer queue used to hand work to the audio callback.
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class SpscQueue
+ * @brief Lock-free ring buffer with one producer thread and one consumer thread.
+ *
+ * Storage is a fixed array sized at compile time, so neither push() nor pop() allocate
+ * or lock. This makes it safe to pop from inside the SDL audio callback.
+ *
+ * @tparam T        Element type. Must be trivially copyable.
+ * @tparam Capacity Maximum number of queued elements. Must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    /**
+     * @brief Adds an element to the back of the queue (producer thread only).
+     * 
+     * @param item The element to add.
+     * @return true if the element was added, false if the queue is full.
+     */
+    bool push(const T& item)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+
+        items_[tail & (Capacity - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the element at the front of the queue (consumer thread only).
+     * 
+     * @param item Receives the removed element.
+     * @return true if an element was removed, false if the queue is empty.
+     */
+    bool pop(T& item)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        item = items_[head & (Capacity - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Checks whether the queue is empty.
+     * 
+     * @return true if there are no queued elements.
+     */
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    T items_[Capacity];                 ///< Ring buffer storage.
+    std::atomic<size_t> head_{0};       ///< Index of the next element to pop (written by the consumer).
+    std::atomic<size_t> tail_{0};       ///< Index of the next free slot (written by the producer).
+};
+
+#endif // SPSC_QUEUE_H
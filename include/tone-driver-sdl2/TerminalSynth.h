@@ -0,0 +1,125 @@
+/// @file TerminalSynth.h
+/// @brief Definition of the TerminalSynth class which plays ToneDriverSDL2 live notes from keys typed in a terminal.
+
+#ifndef TERMINAL_SYNTH_H
+#define TERMINAL_SYNTH_H
+
+#include <chrono>
+#include "NoteName.h"
+#include "tone-driver-sdl2/ToneDriverSDL2.h"
+
+/**
+ * @class TerminalSynth
+ * @brief A keyboard synth in the terminal: no window, just raw key presses turned into noteOn() and noteOff().
+ *
+ * Keys follow the tracker layout: the bottom letter row (`z s x d c v g b h n j m`) plays an
+ * octave from C at the base octave, the top row (`q 2 w 3 e r 5 t 6 y 7 u i`) the octave above.
+ * `-` and `=` move the base octave down and up, space releases every note, and Ctrl-C or
+ * Ctrl-D quits.
+ *
+ * The terminal is put in raw mode, so each key arrives as soon as it is pressed. Terminals
+ * don't report key releases, so a note is held while its key auto-repeats and released
+ * HOLD_MS after it is pressed if no repeat follows (REPEAT_HOLD_MS once it has started
+ * repeating). Standard input can also be a pipe, which makes a scripted run possible.
+ *
+ * After each note starts, the time from the key press to the note's first rendered sample is
+ * printed (see ToneDriverSDL2::getNoteOnLatency()), next to the device buffer length.
+ */
+class TerminalSynth
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param driver     Driver to play on. A warm device (ToneDriverSDL2::setWarmDevice()) gives the lowest latency.
+     * @param baseOctave Octave of the bottom row of keys.
+     */
+    explicit TerminalSynth(ToneDriverSDL2& driver, int baseOctave = DEFAULT_OCTAVE);
+
+    /** @brief Destructor. Restores the terminal if run() was interrupted. */
+    ~TerminalSynth();
+
+    /**
+     * @brief Plays notes from the keyboard until Ctrl-C, Ctrl-D or the end of input.
+     *
+     * @return Number of notes played.
+     */
+    int run();
+
+    /**
+     * @brief Maps a key to a note in the tracker layout.
+     *
+     * @param key        The character typed.
+     * @param baseOctave Octave of the bottom row.
+     * @param note       Receives the note.
+     * @param octave     Receives the octave.
+     * @return false if the key doesn't play a note.
+     */
+    static bool mapKey(char key, int baseOctave, NoteName& note, int& octave);
+
+    static constexpr int DEFAULT_OCTAVE = 4;    ///< Default octave of the bottom row.
+    static constexpr int HOLD_MS = 600;         ///< How long a key press holds its note (longer than the usual auto-repeat delay).
+    static constexpr int REPEAT_HOLD_MS = 120;  ///< How long each auto-repeat holds the note.
+    static constexpr int POLL_MS = 2;           ///< Longest wait for a key before checking for releases.
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief A key whose note is sounding.
+     */
+    struct HeldKey
+    {
+        char key = 0;               ///< The character (0 if the slot is free).
+        NoteName note;              ///< Note being played.
+        int octave = 0;             ///< Octave being played.
+        Clock::time_point releaseAt; ///< When to release the note unless the key repeats.
+    };
+
+    /**
+     * @brief Puts the terminal in raw mode (if standard input is a terminal).
+     */
+    void enterRawMode();
+
+    /**
+     * @brief Restores the terminal mode saved by enterRawMode().
+     */
+    void restoreMode();
+
+    /**
+     * @brief Waits for a key.
+     *
+     * @param timeoutMs Longest wait.
+     * @return The character, -1 if none arrived, or -2 at the end of input.
+     */
+    int readKey(int timeoutMs);
+
+    /**
+     * @brief Handles a key press or auto-repeat.
+     *
+     * @param key The character.
+     * @return true if a note was started.
+     */
+    bool pressKey(char key);
+
+    /**
+     * @brief Releases notes whose keys have stopped repeating.
+     */
+    void releaseExpired();
+
+    /**
+     * @brief Prints the latency of the notes started since the last report.
+     */
+    void reportLatency();
+
+    static constexpr int MAX_HELD_KEYS = 8;     ///< Keys tracked at once.
+
+    ToneDriverSDL2& driver;                     ///< Driver the notes are played on.
+    int baseOctave;                             ///< Octave of the bottom row.
+    HeldKey held[MAX_HELD_KEYS];                ///< Keys whose notes are sounding.
+    Uint64 reportedNotes = 0;                   ///< Notes whose latency has been printed.
+    bool rawMode = false;                       ///< True while the terminal is in raw mode.
+    alignas(8) unsigned char savedMode[128];    ///< Terminal mode to restore (a struct termios on POSIX).
+};
+
+#endif // TERMINAL_SYNTH_H
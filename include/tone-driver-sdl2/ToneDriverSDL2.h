@@ -20,7 +20,54 @@ void Sound::note (int n, int octave)
 #define TONE_DRIVER_SDL2_H
 
 #include <SDL2/SDL.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #include "tone-driver/ToneDriver.h"
+#include "tone-driver/ToneDriverDiagnostics.h"
+#include "tone-driver-sdl2/SpscQueue.h"
+#include "tone-driver-sdl2/AudioThread.h"
+#include "tone-synth/Voice.h"
+#include "tone-synth/NoiseVoice.h"
+#include "tone-synth/ToneAutomation.h"
+#include "tone-synth/RealtimePool.h"
+
+/**
+ * @enum AudioInitMode
+ * @brief When ToneDriverSDL2 initialises SDL audio and opens the device.
+ */
+enum class AudioInitMode {
+    Immediate,  ///< Open the device in the constructor (blocks until the device is ready).
+    Background  ///< Open the device on a background thread. Play calls made before it is ready are held and played once it is.
+};
+
+/**
+ * @enum AudioBus
+ * @brief Independent channels that ToneDriverSDL2 mixes in its audio callback.
+ *
+ * Each bus has its own step queue and voice, so an effect no longer overwrites the tune.
+ */
+enum class AudioBus {
+    Music,      ///< Background music. The blocking ToneDriver calls play alongside it, with its settings.
+    Effects,    ///< Sound effects. Ducks the music by default.
+    Count       ///< Number of buses (not a bus).
+};
+
+/**
+ * @struct AudioBusSettings
+ * @brief Mix level and preemption behaviour of an AudioBus.
+ */
+struct AudioBusSettings
+{
+    float gain = 1.0f;                  ///< Level of the bus in the mix (0.0 to 1.0).
+    int priority = 0;                   ///< While a bus is sounding, buses with a lower priority are ducked or paused.
+    float duckGain = 1.0f;              ///< Gain applied while a higher-priority bus is sounding (0.0 silences the bus but keeps its timing).
+    bool pauseWhenPreempted = false;    ///< Hold the bus's place instead of ducking it, resuming once the higher-priority bus is silent.
+    float pan = 0.0f;                   ///< Stereo position, from -1.0 (left) through 0.0 (centre, full level in both channels) to 1.0 (right).
+    Waveform waveform = Waveform::Buzzer; ///< Waveform of the notes played on the bus (applied from the next note).
+    float pulseWidth = Voice::DEFAULT_PULSE_WIDTH; ///< Duty cycle for Waveform::Pulse.
+};
 
 /**
  * @class ToneDriverSDL2
@@ -33,8 +80,61 @@ void Sound::note (int n, int octave)
 class ToneDriverSDL2 : public ToneDriver
 {
 public:
-    /** @brief Constructor. Initializes the SDL audio system. */
-    ToneDriverSDL2();
+    /**
+     * @brief Times taken to start up, measured from the start of the constructor.
+     *
+     * Each value is negative if that point has not been reached yet.
+     */
+    struct StartupTimings
+    {
+        float constructorMs;    ///< Until the constructor returned (the application can draw its first frame).
+        float deviceReadyMs;    ///< Until the audio device was open.
+        float firstSampleMs;    ///< Until the audio callback rendered the first audible sample.
+    };
+
+    /**
+     * @brief How regularly the audio callback has been scheduled, and how long it took.
+     *
+     * Intervals are only measured between callbacks of one run of the device, so pausing
+     * between notes does not count as lateness.
+     */
+    struct CallbackTimings
+    {
+        Uint64 callbacks;       ///< Buffers rendered.
+        float meanIntervalMs;   ///< Mean time from one callback to the next.
+        float maxIntervalMs;    ///< Longest time from one callback to the next.
+        float maxLatenessMs;    ///< Most a callback started after one buffer duration had passed (0 if never late).
+        float meanRenderMs;     ///< Mean time spent in the callback.
+        float maxRenderMs;      ///< Longest time spent in the callback.
+    };
+
+    /**
+     * @brief Time from noteOn() to the audio callback rendering the note's first sample.
+     *
+     * The note is heard up to one buffer (getBufferDurationMs()) later, once the device has
+     * played the samples queued ahead of it.
+     */
+    struct NoteOnLatency
+    {
+        Uint64 notes;           ///< Notes started.
+        float lastMs;           ///< Latency of the most recent note.
+        float meanMs;           ///< Mean latency.
+        float maxMs;            ///< Worst latency.
+    };
+
+    /**
+     * @brief Constructor. Initializes the SDL audio system.
+     * 
+     * The device is rendered in whatever channel count and sample format (16-bit or float) it
+     * opens with, so SDL never has to convert the stream. Buses are panned across the front
+     * left and right channels; any further channels of a multichannel device are silent.
+     * 
+     * @param initMode Whether to open the device now or on a background thread.
+     * @param channels Output channels to request (1 for mono, 2 for stereo, up to MAX_CHANNELS).
+     * @param requestedBufferSamples Samples per device buffer to request (0 for 1024). Smaller buffers
+     *                 start notes sooner but give the callback less time to run.
+     */
+    explicit ToneDriverSDL2(AudioInitMode initMode = AudioInitMode::Immediate, int channels = DEFAULT_CHANNELS, int requestedBufferSamples = 0);
 
     /** @copydoc ToneDriver::playFrequency(float) */
     void playFrequency(float freq) override;
@@ -42,19 +142,62 @@ public:
     /** @copydoc ToneDriver::playFrequency(float, int) */
     void playFrequency(float freq, int durationMs) override;
 
+    /**
+     * @brief Play a frequency for a fixed duration with pitch and amplitude automation.
+     * 
+     * The automation is described once and evaluated by the audio callback, so glides,
+     * vibrato and ramps are smooth and cost a single call.
+     * 
+     * @param freq Starting frequency in Hertz.
+     * @param durationMs Note duration in milliseconds.
+     * @param automation Pitch and amplitude automation over the note.
+     */
+    void playFrequency(float freq, int durationMs, const ToneAutomation& automation);
+
+    /**
+     * @brief Sweep smoothly from one frequency to another.
+     * 
+     * @param startFreq Starting frequency in Hertz.
+     * @param endFreq Final frequency in Hertz.
+     * @param durationMs Sweep duration in milliseconds.
+     * @param curve Linear (even in Hertz) or exponential (even in semitones) sweep.
+     */
+    void playSweep(float startFreq, float endFreq, int durationMs, GlideCurve curve = GlideCurve::Exponential);
+
     /** @copydoc ToneDriver::playNote(NoteName, int) */
     void playNote(NoteName note, int octave) override;
 
     /** @copydoc ToneDriver::playNote(NoteName, int, int) */
     void playNote(NoteName note, int octave, int durationMs) override;
 
+    /**
+     * @brief Play a musical note for a specific duration with pitch and amplitude automation.
+     * 
+     * @param note Note value (0–11) using the NoteName enum.
+     * @param octave Octave number (0–6).
+     * @param durationMs Note duration in milliseconds.
+     * @param automation Pitch and amplitude automation over the note.
+     */
+    void playNote(NoteName note, int octave, int durationMs, const ToneAutomation& automation);
+
     /** @copydoc ToneDriver::playChord */
     void playChord(const NoteName notes[5], const int octaves[5], int count) override;
 
+    /**
+     * @copydoc ToneDriver::playChord(const NoteName[5], const int[5], int, int)
+     * 
+     * @details The chord is queued as a cycling arpeggio of DEFAULT_CHORD_ARPEGGIO_DELAY_MS
+     *          steps and played by the audio callback for the whole duration.
+     */
+    void playChord(const NoteName notes[5], const int octaves[5], int count, int durationMs) override;
+
     /** @copydoc ToneDriver::playArpeggio */
     void playArpeggio(const NoteName notes[5], const int octaves[5], int count, int noteDurationMs = DEFAULT_NOTE_DURATION_MS, int delayMs = DEFAULT_ARPEGGIO_DELAY_MS) override;
 
-    /** @copydoc ToneDriver::playArpeggio */
+    /** @copydoc ToneDriver::playSequence */
+    void playSequence(const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs) override;
+
+    /** @copydoc ToneDriver::stop */
     void stop() override;
 
     /** @copydoc ToneDriver::stopAfter */
@@ -78,6 +221,17 @@ public:
      */
     void setNoteFrequency(NoteName note, int octave);
 
+    /**
+     * @brief Play pre-rendered mono 16-bit PCM, such as a StaticSong, straight from memory.
+     * 
+     * The samples are read in place by the audio callback (never copied), so they can live in
+     * read-only memory. Blocks until every sample has been played, like the other timed calls.
+     * 
+     * @param samples Samples at SAMPLE_RATE. Must stay valid until the call returns.
+     * @param count   Number of samples.
+     */
+    void playSamples(const Sint16* samples, int count);
+
     /**
      * @brief Set the amplitude (volume) of the output tone.
      * 
@@ -85,13 +239,377 @@ public:
      */
     void setAmplitude(float amplitude);
 
-    /** @copydoc ToneDriver::isValidNote */
+    /**
+     * @copydoc ToneDriver::isValidNote
+     * 
+     * @details Invalid notes are reported to getDiagnostics() rather than printed, so a bad
+     *          data file cannot stall the play path on stream I/O.
+     */
     bool isValidNote(NoteName note, int octave) override;
 
+    /**
+     * @brief Error counters and the rate-limited error log for this driver.
+     * 
+     * Logged errors are printed to std::cerr after each blocking call and when the driver is
+     * destroyed (change or disable this with getDiagnostics().setOutput()). Call
+     * getDiagnostics().drain() to print them at other times, and
+     * getDiagnostics().getErrorCount() to query how often each error has happened.
+     * 
+     * @return The driver's diagnostics.
+     */
+    ToneDriverDiagnostics& getDiagnostics();
+
+    /**
+     * @brief Keep the audio device running between notes.
+     *
+     * In warm mode the device is unpaused once and primed with silence. Notes are then
+     * gated on and off inside the audio callback instead of pausing and unpausing the
+     * device for every note, which removes the device restart from each note onset.
+     *
+     * @param enabled True to keep the device running, false to pause it between notes.
+     */
+    void setWarmDevice(bool enabled);
+
+    /**
+     * @brief Check whether the device is kept running between notes.
+     *
+     * @return true if warm mode is enabled, false otherwise.
+     */
+    bool isWarmDevice() const;
+
+    /**
+     * @brief Time from the most recent note being requested to its first sample being rendered.
+     *
+     * @return Onset latency in milliseconds, or a negative value if no note has been rendered yet.
+     */
+    float getOnsetLatencyMs() const;
+
+    /**
+     * @brief Duration of one audio device buffer.
+     *
+     * @return Buffer duration in milliseconds. Onset latency should stay within this.
+     */
+    float getBufferDurationMs() const;
+
+    /**
+     * @brief Number of channels the device was opened with.
+     *
+     * @return Output channels (the requested count until the device is open).
+     */
+    int getOutputChannels() const;
+
+    /**
+     * @brief Startup times to the first frame, the open device and the first audible sample.
+     * 
+     * @return The startup timings.
+     */
+    StartupTimings getStartupTimings() const;
+
+    /**
+     * @brief Scheduling interval and render time of the audio callback since construction or the last reset.
+     * 
+     * @return The callback timings.
+     */
+    CallbackTimings getCallbackTimings() const;
+
+    /**
+     * @brief Restarts the callback timings from the next buffer.
+     */
+    void resetCallbackTimings();
+
+    /**
+     * @brief Queue a note on a bus and return immediately.
+     *
+     * Buses are mixed in the audio callback, so an effect queued on AudioBus::Effects plays
+     * over (and by default ducks) music on AudioBus::Music. Each bus should be fed from one
+     * thread at a time.
+     *
+     * @param bus The bus to play on.
+     * @param note Note value (0–11) using the NoteName enum.
+     * @param octave Octave number (0–6).
+     * @param durationMs Note duration in milliseconds.
+     * @param automation Pitch and amplitude automation over the note.
+     */
+    void queueNote(AudioBus bus, NoteName note, int octave, int durationMs, const ToneAutomation& automation = ToneAutomation());
+
+    /**
+     * @brief Queue a frequency on a bus and return immediately.
+     *
+     * @param bus The bus to play on.
+     * @param freq Frequency in Hertz.
+     * @param durationMs Duration in milliseconds.
+     * @param automation Pitch and amplitude automation over the tone.
+     */
+    void queueFrequency(AudioBus bus, float freq, int durationMs, const ToneAutomation& automation = ToneAutomation());
+
+    /**
+     * @brief Queue a silence on a bus and return immediately.
+     *
+     * @param bus The bus.
+     * @param durationMs Duration in milliseconds.
+     */
+    void queueRest(AudioBus bus, int durationMs);
+
+    /**
+     * @brief Queue a run of notes, each followed by a rest, on a bus and return immediately.
+     *
+     * @param bus The bus to play on.
+     * @param notes Array of notes.
+     * @param octaves Array of octaves, one per note.
+     * @param count Number of notes.
+     * @param noteDurationMs Duration of each note in milliseconds.
+     * @param restMs Silence after each note in milliseconds.
+     */
+    void queueSequence(AudioBus bus, const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs);
+
+    /**
+     * @brief Start a live note, as from a keyboard, and return immediately.
+     *
+     * The note-on is passed to the audio callback through a lock-free queue and starts at the
+     * next mix chunk (MIX_CHUNK samples), then sounds until noteOff(). Up to MAX_LIVE_NOTES
+     * notes sound at once on the music bus, with its waveform, gain and pan, alongside anything
+     * queued there. A note-on for a note that is already sounding restarts it. Live notes
+     * should be played from one thread.
+     *
+     * @param note Note value (0–11) using the NoteName enum.
+     * @param octave Octave number (0–6).
+     */
+    void noteOn(NoteName note, int octave);
+
+    /**
+     * @brief Release a live note started by noteOn(). It fades out over a few milliseconds.
+     *
+     * @param note Note value (0–11) using the NoteName enum.
+     * @param octave Octave number (0–6).
+     */
+    void noteOff(NoteName note, int octave);
+
+    /**
+     * @brief Release every live note.
+     */
+    void allNotesOff();
+
+    /**
+     * @brief Time from noteOn() to each live note's first rendered sample.
+     *
+     * @return The latency of the notes started so far.
+     */
+    NoteOnLatency getNoteOnLatency() const;
+
+    /**
+     * @brief Queue a percussion hit of LFSR noise on a bus and return immediately.
+     *
+     * The hit lasts hit.durationMs and is rendered by a NoiseVoice in the audio callback.
+     * Presets such as noiseSnare() and noiseHiHat() are in NoiseVoice.h.
+     *
+     * @param bus The bus to play on.
+     * @param hit Clock, mode, decay, length and level of the hit.
+     */
+    void queueNoise(AudioBus bus, const NoiseHit& hit);
+
+    /**
+     * @brief Queue pre-rendered samples on a bus and return immediately.
+     *
+     * @param bus The bus to play on.
+     * @param samples Mono samples at SAMPLE_RATE. Must stay valid until they have played.
+     * @param count Number of samples.
+     */
+    void queueSamples(AudioBus bus, const Sint16* samples, int count);
+
+    /**
+     * @brief Loop pre-rendered samples on a bus, gaplessly, until released or cleared, and return immediately.
+     *
+     * Plays from the start of the buffer to loopEnd, then jumps back to loopStart on the exact
+     * sample each time loopEnd is reached, so the seam is as clean as the material. Samples
+     * before loopStart play once as an intro; after releaseLoop() the current pass carries on
+     * past loopEnd to the end of the buffer as an outro, then the bus moves on to whatever was
+     * queued after the loop. The samples are read in place by the audio callback and the
+     * calling thread does no further work.
+     *
+     * Only the first pass counts towards getBusSamplesQueued() and getBusSamplesRendered(): the
+     * loop counts as played once it first reaches loopEnd, so isBusPlaying() and waitForBus()
+     * don't wait on a loop that is still wrapping.
+     *
+     * @param bus The bus to play on.
+     * @param samples Mono samples at SAMPLE_RATE. Must stay valid until the loop has been released and played out, or cleared.
+     * @param count Number of samples.
+     * @param loopStart First sample of the looped section.
+     * @param loopEnd Sample after the looped section (-1 for the end of the buffer).
+     */
+    void queueLoop(AudioBus bus, const Sint16* samples, int count, int loopStart = 0, int loopEnd = -1);
+
+    /**
+     * @brief Let the loop playing on a bus finish: it plays on to the end of its buffer instead of wrapping.
+     *
+     * If no loop is playing, the next loop to reach its end is released.
+     *
+     * @param bus The bus.
+     */
+    void releaseLoop(AudioBus bus);
+
+    /**
+     * @brief Drop everything queued on a bus, silencing it from the next buffer.
+     *
+     * @param bus The bus to clear.
+     */
+    void clearBus(AudioBus bus);
+
+    /**
+     * @brief Check whether a bus has anything left to play.
+     *
+     * @param bus The bus.
+     * @return true until the callback has rendered everything queued on the bus.
+     */
+    bool isBusPlaying(AudioBus bus) const;
+
+    /**
+     * @brief Gets the total number of samples queued on a bus since construction.
+     *
+     * @param bus The bus.
+     * @return Samples queued.
+     */
+    Uint64 getBusSamplesQueued(AudioBus bus) const;
+
+    /**
+     * @brief Gets the total number of queued samples the callback has played (or dropped) on a bus.
+     *
+     * A sample queued when getBusSamplesQueued() returned n has been heard once this exceeds n.
+     *
+     * @param bus The bus.
+     * @return Samples rendered.
+     */
+    Uint64 getBusSamplesRendered(AudioBus bus) const;
+
+    /**
+     * @brief Block until a bus has finished playing.
+     *
+     * @param bus The bus.
+     */
+    void waitForBus(AudioBus bus);
+
+    /**
+     * @brief Set the level and preemption behaviour of a bus.
+     *
+     * @param bus The bus.
+     * @param settings The new settings, applied from the next buffer.
+     */
+    void setBusSettings(AudioBus bus, const AudioBusSettings& settings);
+
+    /**
+     * @brief Gets the level and preemption behaviour of a bus.
+     *
+     * @param bus The bus.
+     * @return The bus settings.
+     */
+    AudioBusSettings getBusSettings(AudioBus bus) const;
+
+    /**
+     * @brief Request a scheduling priority and CPU affinity for the audio callback thread.
+     *
+     * The options are applied by the callback thread itself at the start of its next buffer,
+     * falling back to a lower priority if the process lacks permission. Check the result with
+     * getAudioThreadStatus() once audio has played.
+     *
+     * @param options The requested priority and CPU mask.
+     */
+    void setAudioThreadOptions(const AudioThreadOptions& options);
+
+    /**
+     * @brief Gets the scheduling the audio callback thread actually obtained.
+     *
+     * @return The achieved priority and CPU mask (applied is false until the callback has run with the latest options).
+     */
+    AudioThreadStatus getAudioThreadStatus() const;
+
     /** @brief Destructor. Closes SDL audio subsystem. */
     ~ToneDriverSDL2();
 
+    static constexpr int SAMPLE_RATE = 44100;   ///< Audio sample rate in Hz.
+    static constexpr int DEFAULT_CHANNELS = 2;  ///< Output channels requested by default (stereo).
+    static constexpr int MAX_CHANNELS = 8;      ///< Most output channels that can be requested (7.1).
+
 private:
+    /**
+     * @brief One step of a sequence scheduled in the audio callback.
+     */
+    struct SequenceStep
+    {
+        float frequency;    ///< Frequency in Hertz (0 for a rest).
+        Uint32 samples;     ///< Step duration in samples.
+        const Sint16* pcm;  ///< Pre-rendered samples to play instead of a tone (nullptr for a tone or rest).
+        ToneAutomation automation; ///< Pitch and amplitude automation over the step.
+        Uint32 loopStart = 0; ///< Sample of pcm to jump back to when loopEnd is reached.
+        Uint32 loopEnd = 0;   ///< Sample of pcm at which to jump back to loopStart (0 for no loop).
+        bool noise = false;   ///< True to play noiseHit instead of a tone.
+        NoiseHit noiseHit = NoiseHit(); ///< Percussion hit to play if noise is set.
+    };
+
+    static constexpr size_t MAX_SEQUENCE_STEPS = 512;  ///< Capacity of each bus's step queue.
+    static constexpr size_t VOICE_POOL_SIZE = 12;      ///< Number of voices the audio callback can have in use.
+    static constexpr int MAX_LIVE_NOTES = 6;           ///< Live notes that can sound at once.
+    static constexpr size_t MAX_LIVE_EVENTS = 64;      ///< Capacity of the live note event queue.
+    static constexpr float LIVE_RELEASE_STEP = 1.0f / 256; ///< Change in a released live note's level per sample (about 6 ms).
+    static constexpr size_t NOISE_POOL_SIZE = 4;       ///< Number of noise voices the audio callback can have in use.
+    static constexpr int BUS_COUNT = int(AudioBus::Count); ///< Number of buses.
+    static constexpr int FOREGROUND_BUS = BUS_COUNT;   ///< Internal bus of the blocking calls, mixed with the music bus's settings.
+    static constexpr int MIX_BUS_COUNT = BUS_COUNT + 1; ///< Buses mixed by the callback, the foreground bus included.
+    static constexpr int MIX_CHUNK = 256;              ///< Samples mixed at a time (bounds the mix buffer on the stack).
+    static constexpr float DUCK_RAMP_STEP = 1.0f / 256; ///< Change in ducking gain per sample (about 6 ms for a full duck).
+
+    /**
+     * @brief Sequencer state of one AudioBus.
+     */
+    struct Bus
+    {
+        SpscQueue<SequenceStep, MAX_SEQUENCE_STEPS> steps;  ///< Steps waiting to be played by the callback.
+        SequenceStep step = {0.0f, 0, nullptr, ToneAutomation()}; ///< Step currently being played (callback only).
+        Uint32 remaining = 0;                       ///< Samples left in the current step (callback only).
+        Voice* voice = nullptr;                     ///< Voice playing the current step (callback only).
+        NoiseVoice* noise = nullptr;                ///< Noise voice playing the current step (callback only).
+        float duck = 1.0f;                          ///< Ducking gain, ramped towards its target (callback only).
+        unsigned clearsApplied = 0;                 ///< Last clear request handled (callback only).
+
+        std::atomic<float> gain{1.0f};              ///< Level of the bus in the mix.
+        std::atomic<int> priority{0};               ///< Preemption priority.
+        std::atomic<float> duckGain{1.0f};          ///< Gain while preempted.
+        std::atomic<bool> pauseWhenPreempted{false}; ///< Hold position instead of ducking while preempted.
+        std::atomic<float> pan{0.0f};               ///< Stereo position (-1.0 left to 1.0 right).
+        std::atomic<int> waveform{int(Waveform::Buzzer)}; ///< Waveform of new notes.
+        std::atomic<float> pulseWidth{Voice::DEFAULT_PULSE_WIDTH}; ///< Duty cycle of new Waveform::Pulse notes.
+        float panLeft = 1.0f;                       ///< Left gain reached at the end of the last chunk (callback only).
+        float panRight = 1.0f;                      ///< Right gain reached at the end of the last chunk (callback only).
+        bool wasActive = false;                     ///< True if the bus was sounding in the last chunk (callback only).
+        unsigned loopReleasesApplied = 0;           ///< Last loop release handled (callback only).
+        bool replaying = false;                     ///< True once the current loop has wrapped, its samples already counted as rendered (callback only).
+
+        std::atomic<unsigned> clearRequests{0};     ///< Incremented by clearBus().
+        std::atomic<unsigned> loopReleases{0};      ///< Incremented by releaseLoop().
+        std::atomic<Uint64> samplesQueued{0};       ///< Total samples submitted as steps.
+        std::atomic<Uint64> samplesRendered{0};     ///< Total step samples rendered or dropped by the callback.
+    };
+
+    /**
+     * @brief A note-on or note-off on its way to the audio callback.
+     */
+    struct LiveEvent
+    {
+        float frequency;    ///< Frequency in Hertz (note-on only).
+        int key;            ///< Semitones above C0 (octave * 12 + note), or -1 for every note.
+        bool on;            ///< True for a note-on, false for a note-off.
+        Uint64 ticks;       ///< Performance counter when the event was sent.
+    };
+
+    /**
+     * @brief A live note sounding in the audio callback.
+     */
+    struct LiveNote
+    {
+        Voice* voice = nullptr;     ///< Voice playing the note, or nullptr if the slot is free.
+        int key = -1;               ///< Semitones above C0.
+        float level = 0.0f;         ///< Current level, ramped down after a note-off.
+        bool releasing = false;     ///< True once the note has been released.
+    };
+
     /**
      * @brief SDL audio callback function used to fill the audio buffer.
      * 
@@ -104,13 +622,175 @@ private:
     static void audioCallback(void* userdata, Uint8* stream, int len);
 
     /**
-     * @brief Fills the audio buffer with a square wave based on current frequency and amplitude.
+     * @brief Fills the audio buffer with the buses mixed, panned and interleaved in the device's own format.
      *
      * @param stream Audio buffer to write to.
      * @param len    Length of the audio buffer in bytes.
      */
     void generateSquareWave(Uint8* stream, int len);
 
+    /**
+     * @brief Mixes a bus's queued steps into the mix buffer (audio callback only).
+     *
+     * @param index     Index of the bus.
+     * @param mix       Mix buffer to add to.
+     * @param samples   Number of samples to mix.
+     * @param preempted True if a higher-priority bus is sounding.
+     */
+    void renderBus(int index, float* mix, int samples, bool preempted);
+
+    /**
+     * @brief Mixes the gated tone started by playNote() or playFrequency() into the mix buffer (audio callback only).
+     *
+     * @param bus        The bus the gated tone plays on (the foreground bus).
+     * @param mix        Mix buffer to add to.
+     * @param samples    Number of samples to mix.
+     * @param duckTarget Ducking gain to ramp towards.
+     * @return Number of samples mixed (0 if the gate is closed).
+     */
+    int mixGatedTone(Bus& bus, float* mix, int samples, float duckTarget);
+
+    /**
+     * @brief Starts and releases live notes sent by noteOn() and noteOff() (audio callback only).
+     */
+    void applyLiveEvents();
+
+    /**
+     * @brief Mixes the live notes into the mix buffer (audio callback only).
+     *
+     * @param bus     The bus the live notes play on (AudioBus::Music).
+     * @param mix     Mix buffer to add to.
+     * @param samples Number of samples to mix.
+     */
+    void mixLiveNotes(Bus& bus, float* mix, int samples);
+
+    /**
+     * @brief Sends a live note event to the audio callback, waiting for space if the queue is full.
+     *
+     * @param event The event.
+     */
+    void pushLiveEvent(const LiveEvent& event);
+
+    /**
+     * @brief Copies settings into a bus, to be applied from the next buffer.
+     *
+     * @param target   The bus.
+     * @param settings The new settings.
+     */
+    static void applyBusSettings(Bus& target, const AudioBusSettings& settings);
+
+    /**
+     * @brief Moves a bus on to its next queued step, skipping empty steps (audio callback only).
+     *
+     * @param bus The bus.
+     * @return false if nothing is queued.
+     */
+    bool nextStep(Bus& bus);
+
+    /**
+     * @brief Drops a bus's queued steps if clearBus() has been called (audio callback only).
+     *
+     * @param bus The bus.
+     */
+    void applyBusClear(Bus& bus);
+
+    /**
+     * @brief Checks whether a bus has something to play (audio callback only).
+     *
+     * @param index Index of the bus.
+     * @return true if a step is playing or queued, the gated tone is sounding (foreground bus) or a live note is (music bus).
+     */
+    bool isBusActive(int index);
+
+    /**
+     * @brief Checks whether a bus has a step or loop playing or queued (audio callback only).
+     *
+     * @param bus The bus.
+     * @return true if the bus has steps left to play.
+     */
+    static bool hasStepWork(const Bus& bus);
+
+    /**
+     * @brief Takes a voice from the pool, reporting if none are left (audio callback only).
+     *
+     * @param voice Set to the voice, or nullptr if none are left.
+     * @return true if a voice was acquired.
+     */
+    bool acquireVoice(Voice*& voice);
+
+    /**
+     * @brief Gives a voice the waveform set for its bus (audio callback only).
+     *
+     * @param bus   The bus.
+     * @param voice The voice.
+     */
+    void applyWaveform(const Bus& bus, Voice& voice);
+
+    /**
+     * @brief Takes a noise voice from the pool, reporting if none are left (audio callback only).
+     *
+     * @param voice Set to the voice, or nullptr if none are left.
+     * @return true if a voice was acquired.
+     */
+    bool acquireVoice(NoiseVoice*& voice);
+
+    /**
+     * @brief Applies new audio thread options if any have been requested (audio callback only).
+     */
+    void applyThreadOptions();
+
+    /**
+     * @brief Returns a voice to the pool (audio callback only).
+     *
+     * @param voice The voice, set to nullptr.
+     */
+    void releaseVoice(Voice*& voice);
+
+    /**
+     * @brief Returns a noise voice to the pool (audio callback only).
+     *
+     * @param voice The voice, set to nullptr.
+     */
+    void releaseVoice(NoiseVoice*& voice);
+
+    /**
+     * @brief Initialises SDL audio and opens the device, then applies any pending play or stop.
+     */
+    void openDevice();
+
+    /**
+     * @brief Pauses or unpauses the device, or records the request if the device is not open yet.
+     *
+     * @param paused True to pause, false to start playback.
+     */
+    void setDevicePaused(bool paused);
+
+    /**
+     * @brief Blocks until the audio device is open.
+     */
+    void waitForDevice();
+
+    /**
+     * @brief Records when the callback renders its first audible sample.
+     */
+    void markFirstSample();
+
+    /**
+     * @brief Adds one callback to the callback timings (audio callback only).
+     *
+     * @param startTicks Performance counter when the callback started.
+     * @param endTicks   Performance counter when it finished rendering.
+     */
+    void recordCallbackTiming(Uint64 startTicks, Uint64 endTicks);
+
+    /**
+     * @brief Opens the note gate and starts the device if it is not being kept warm.
+     *
+     * @details Phase reset and onset timing are handed to the audio callback so the
+     *          calling thread never touches the waveform state directly.
+     */
+    void startTone();
+
     /**
      * @brief Computes the semitone distance between two notes across octaves.
      *
@@ -123,12 +803,127 @@ private:
      */
     int getSemitonesDiff(NoteName note1, int octave1, NoteName note2, int octave2);
 
-    float currentFrequency = 0.0f;  ///< Currently playing frequency (Hz).
-    float currentAmplitude = 0.85f; ///< Current volume (0.0 to 1.0).
-    int remainingSamples = 0;       ///< Remaining samples for timed playback.
-    int timeIndex = 0;              ///< Sample index used to track waveform phase.
+    /**
+     * @brief Computes the frequency of a note relative to the reference pitch.
+     *
+     * @param note Note (0–11).
+     * @param octave Octave number (0–6).
+     * 
+     * @returns Frequency in Hertz.
+     */
+    float getNoteFrequency(NoteName note, int octave);
+
+    /**
+     * @brief Queues a step on a bus for the audio callback, waiting for space if the queue is full.
+     *
+     * @param index Index of the bus (an AudioBus, or FOREGROUND_BUS).
+     * @param frequency Starting frequency in Hertz, or 0 for silence.
+     * @param durationMs Step duration in milliseconds.
+     * @param automation Pitch and amplitude automation over the step.
+     */
+    void queueStep(int index, float frequency, int durationMs, const ToneAutomation& automation = ToneAutomation());
+
+    /**
+     * @brief Queues a step on a bus for the audio callback, waiting for space if the queue is full.
+     *
+     * @param index Index of the bus (an AudioBus, or FOREGROUND_BUS).
+     * @param step The step to play.
+     */
+    void pushStep(int index, const SequenceStep& step);
+
+    /**
+     * @brief Checks whether the callback has yet to render samples queued on a bus.
+     *
+     * @param index Index of the bus (an AudioBus, or FOREGROUND_BUS).
+     * @return true until everything queued on the bus has been rendered.
+     */
+    bool hasQueuedSamples(int index) const;
+
+    /**
+     * @brief Checks whether anything besides the gated tone still needs the device running.
+     *
+     * @return true if a bus has samples queued or a loop playing, or a live note is sounding or on its way.
+     */
+    bool hasPendingWork() const;
+
+    /**
+     * @brief Starts the device with the note gate closed, ready to play steps queued on the foreground bus.
+     */
+    void startSequence();
+
+    /**
+     * @brief Blocks until the callback has rendered every step queued on the foreground bus, then stops playback.
+     *
+     * Steps queued with the queue* calls don't hold it up, so a loop on the music bus can't block it.
+     */
+    void finishSequence();
+
+    /**
+     * @brief Reports an invalid number of notes for a chord or arpeggio.
+     *
+     * @param count The number of notes requested.
+     * @return true if the count is valid, false otherwise.
+     */
+    bool isValidNoteCount(int count);
+
+    std::atomic<float> currentFrequency{0.0f};  ///< Currently playing frequency (Hz).
+    std::atomic<float> currentAmplitude{0.85f}; ///< Current volume (0.0 to 1.0).
+    RealtimePool<Voice> voicePool{VOICE_POOL_SIZE}; ///< Voices for the audio callback, allocated at construction.
+    RealtimePool<NoiseVoice> noisePool{NOISE_POOL_SIZE}; ///< Noise voices for the audio callback, allocated at construction.
+    Voice* gateVoice = nullptr;                 ///< Voice playing the gated tone, or nullptr (audio callback only).
+    Bus buses[MIX_BUS_COUNT];                   ///< Music, effects and foreground buses, mixed by the callback.
+    SpscQueue<LiveEvent, MAX_LIVE_EVENTS> liveEvents; ///< Note-ons and note-offs waiting for the callback.
+    LiveNote liveNotes[MAX_LIVE_NOTES];         ///< Live notes sounding (callback only).
+    std::atomic<Uint64> noteOnLatencyCount{0};  ///< Live notes started.
+    std::atomic<Uint64> noteOnLatencyTotalTicks{0}; ///< Sum of the live note latencies.
+    std::atomic<Uint64> noteOnLatencyMaxTicks{0}; ///< Worst live note latency.
+    std::atomic<Uint64> noteOnLatencyLastTicks{0}; ///< Latency of the most recent live note.
+
+    std::atomic<bool> gateOpen{false};          ///< True while a note should be sounding.
+    std::atomic<bool> busesSounding{false};     ///< True if a bus had steps or a loop, or a live note sounded, in the last chunk (written by the callback).
+    std::atomic<bool> warmDevice{false};        ///< True if the device is kept running between notes.
+    std::atomic<unsigned> noteOnCount{0};       ///< Incremented for every note start. Tells the callback to reset phase.
+    unsigned renderedNoteOnCount = 0;           ///< Last note start seen by the audio callback.
+    std::atomic<Uint64> noteOnTicks{0};         ///< Performance counter value when the last note was requested.
+    std::atomic<Uint64> onsetLatencyTicks{0};   ///< Performance counter ticks from note request to first sample.
+    std::atomic<bool> onsetMeasured{false};     ///< True once at least one onset has been measured.
+    std::atomic<int> bufferSamples{BUFFER_SAMPLES}; ///< Samples per device buffer, as obtained from SDL.
+    std::atomic<int> outputChannels{DEFAULT_CHANNELS}; ///< Channels per frame, as obtained from SDL.
+    std::atomic<bool> floatOutput{false};       ///< True if the device takes 32-bit float samples rather than 16-bit.
+
+    std::thread initThread;                     ///< Opens the device in AudioInitMode::Background.
+    std::mutex deviceMutex;                     ///< Guards opening and pausing the device (never taken by the callback).
+    std::condition_variable deviceReadyCondition; ///< Signalled once the device is open.
+    bool deviceReady = false;                   ///< True once the device is open.
+    bool deviceRunning = false;                 ///< Requested device state: true to play, false to pause.
+    Uint64 constructTicks = 0;                  ///< Performance counter at the start of the constructor.
+    Uint64 constructedTicks = 0;                ///< Performance counter at the end of the constructor.
+    std::atomic<Uint64> deviceReadyTicks{0};    ///< Performance counter when the device finished opening.
+    std::atomic<Uint64> firstSampleTicks{0};    ///< Performance counter when the first audible sample was rendered.
+
+    std::atomic<unsigned> deviceStarts{0};      ///< Incremented each time the device is unpaused.
+    unsigned timedDeviceStarts = 0;             ///< Last device start seen by the callback timings (callback only).
+    Uint64 lastCallbackTicks = 0;               ///< Performance counter at the start of the previous callback (callback only).
+    std::atomic<unsigned> callbackTimingResets{0}; ///< Incremented by resetCallbackTimings().
+    unsigned callbackTimingResetsApplied = 0;   ///< Last reset handled (callback only).
+    std::atomic<Uint64> callbackCount{0};       ///< Callbacks timed.
+    std::atomic<Uint64> callbackIntervals{0};   ///< Intervals measured between callbacks.
+    std::atomic<Uint64> callbackIntervalTicks{0}; ///< Sum of the measured intervals.
+    std::atomic<Uint64> maxCallbackIntervalTicks{0}; ///< Longest measured interval.
+    std::atomic<Uint64> callbackRenderTicks{0}; ///< Sum of the time spent in the callback.
+    std::atomic<Uint64> maxCallbackRenderTicks{0}; ///< Longest time spent in the callback.
+
+    std::atomic<int> requestedThreadPriority{int(AudioThreadPriority::Normal)}; ///< Priority requested for the audio thread.
+    std::atomic<uint64_t> requestedCpuMask{0};  ///< CPU mask requested for the audio thread.
+    std::atomic<unsigned> threadOptionsVersion{0}; ///< Incremented for every setAudioThreadOptions() call.
+    unsigned appliedThreadOptionsVersion = 0;   ///< Last version applied by the audio callback.
+    std::atomic<bool> threadOptionsApplied{false}; ///< True once the latest options have been applied.
+    std::atomic<int> achievedThreadPriority{int(AudioThreadPriority::Normal)}; ///< Priority the audio thread obtained.
+    std::atomic<uint64_t> achievedCpuMask{0};   ///< CPU mask in effect on the audio thread.
+
+    ToneDriverDiagnostics diagnostics;          ///< Errors reported on the play path.
 
-    const static int SAMPLE_RATE;   ///< Audio sample rate in Hz.
+    const static int BUFFER_SAMPLES;///< Requested samples per device buffer.
     const static int REF_FREQ;      ///< Frequency reference (usually A4 = 440Hz).
     const static NoteName REF_NOTE; ///< Reference note (usually A).
     const static int REF_OCTAVE;    ///< Octave of reference note (usually 4).
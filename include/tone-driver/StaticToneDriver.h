@@ -0,0 +1,196 @@
+/// @file StaticToneDriver.h
+/// @brief Definition of the StaticToneDriver class template, a statically dispatched (CRTP) form of the ToneDriver interface.
+
+#ifndef STATIC_TONE_DRIVER_H
+#define STATIC_TONE_DRIVER_H
+
+#include "NoteName.h"
+
+/**
+ * @class StaticToneDriver
+ * @brief The ToneDriver API without virtual functions, for constrained targets and tight loops.
+ *
+ * A backend derives from StaticToneDriver<Backend> (the curiously recurring template pattern)
+ * and provides three primitives, in the style of the Arduino tone(), noTone() and delay() calls:
+ *
+ * @code
+ * class ToneDriverAttiny : public StaticToneDriver<ToneDriverAttiny>
+ * {
+ * public:
+ *     void startTone(float freq);  // Start a square wave (keeps playing until stopTone())
+ *     void stopTone();             // Silence the output
+ *     void waitMs(int durationMs); // Block for a duration while the tone plays on
+ * };
+ * @endcode
+ *
+ * Every ToneDriver call (playNote(), playChord(), playSequence()...) is built on those, and
+ * each call is made through the Backend type, so the compiler can inline the whole chain. There
+ * is no vtable, no RTTI and no heap use. A backend can replace any of the calls with a better
+ * one (for example a sample-accurate playSequence()) by declaring a function with the same
+ * signature; the templated MusicDriver functions and the other calls here will use it.
+ *
+ * Use ToneDriver instead when the backend has to be chosen at runtime.
+ *
+ * @tparam Backend The class deriving from StaticToneDriver.
+ */
+template <typename Backend>
+class StaticToneDriver
+{
+public:
+    static constexpr int DEFAULT_CHORD_ARPEGGIO_DELAY_MS = 25; ///< Delay between notes when using an arpeggio to simulate playing a chord
+    static constexpr int DEFAULT_NOTE_DURATION_MS = 100;       ///< Default note duration
+    static constexpr int DEFAULT_ARPEGGIO_DELAY_MS = 100;      ///< Delay between notes in an arpeggio
+    static constexpr int MAX_POLYPHONY = 5;                    ///< Maximum number of notes supported in a chord or arpeggio
+    static constexpr int MAX_OCTAVE = 6;                       ///< Maximum octave index supported (inclusive). Valid range: 0–6.
+
+    /** @copydoc ToneDriver::playFrequency(float) */
+    void playFrequency(float freq)
+    {
+        backend().startTone(freq);
+    }
+
+    /** @copydoc ToneDriver::playFrequency(float, int) */
+    void playFrequency(float freq, int durationMs)
+    {
+        backend().startTone(freq);
+        backend().waitMs(durationMs);
+        backend().stopTone();
+    }
+
+    /** @copydoc ToneDriver::playNote(NoteName, int) */
+    void playNote(NoteName note, int octave)
+    {
+        if (backend().isValidNote(note, octave))
+        {
+            backend().playFrequency(getNoteFrequency(note, octave));
+        }
+    }
+
+    /** @copydoc ToneDriver::playNote(NoteName, int, int) */
+    void playNote(NoteName note, int octave, int durationMs)
+    {
+        if (backend().isValidNote(note, octave))
+        {
+            backend().playFrequency(getNoteFrequency(note, octave), durationMs);
+        }
+    }
+
+    /** @copydoc ToneDriver::playChord(const NoteName[], const int[], int) */
+    void playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count)
+    {
+        backend().playArpeggio(notes, octaves, count, DEFAULT_CHORD_ARPEGGIO_DELAY_MS);
+    }
+
+    /**
+     * @copydoc ToneDriver::playChord(const NoteName[], const int[], int, int)
+     * @details Played as a cycling arpeggio of DEFAULT_CHORD_ARPEGGIO_DELAY_MS steps.
+     */
+    void playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int durationMs)
+    {
+        if (count < 1 || count > MAX_POLYPHONY)
+        {
+            return;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (!backend().isValidNote(notes[i], octaves[i]))
+            {
+                return;
+            }
+        }
+
+        // Cycle through the chord tones for the whole duration
+        for (int elapsedMs = 0, i = 0; elapsedMs < durationMs; elapsedMs += DEFAULT_CHORD_ARPEGGIO_DELAY_MS, i = (i + 1) % count)
+        {
+            int stepMs = (durationMs - elapsedMs < DEFAULT_CHORD_ARPEGGIO_DELAY_MS) ? durationMs - elapsedMs : DEFAULT_CHORD_ARPEGGIO_DELAY_MS;
+            backend().startTone(getNoteFrequency(notes[i], octaves[i]));
+            backend().waitMs(stepMs);
+        }
+
+        backend().stopTone();
+    }
+
+    /** @copydoc ToneDriver::playArpeggio */
+    void playArpeggio(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int noteDurationMs = DEFAULT_NOTE_DURATION_MS, int delayMs = DEFAULT_ARPEGGIO_DELAY_MS)
+    {
+        if (count >= 1 && count <= MAX_POLYPHONY)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                backend().playNote(notes[i], octaves[i], noteDurationMs);
+                backend().rest(delayMs);
+            }
+        }
+    }
+
+    /** @copydoc ToneDriver::playSequence */
+    void playSequence(const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            backend().playNote(notes[i], octaves[i], noteDurationMs);
+            backend().rest(restMs);
+        }
+    }
+
+    /** @copydoc ToneDriver::stop */
+    void stop()
+    {
+        backend().stopTone();
+    }
+
+    /** @copydoc ToneDriver::stopAfter */
+    void stopAfter(int durationMs)
+    {
+        backend().waitMs(durationMs);
+        backend().stopTone();
+    }
+
+    /** @copydoc ToneDriver::rest */
+    void rest(int durationMs)
+    {
+        backend().stopTone();
+        backend().waitMs(durationMs);
+    }
+
+    /** @copydoc ToneDriver::isValidNote */
+    bool isValidNote(NoteName note, int octave)
+    {
+        return note >= NoteName::C && note <= NoteName::B && octave >= 0 && octave <= MAX_OCTAVE;
+    }
+
+    /**
+     * @brief Calculates the frequency of a note from a table, without pow().
+     *
+     * @param note Note value (0–11).
+     * @param octave Octave number (0–6).
+     * @return Frequency in Hertz (A4 = 440Hz).
+     */
+    static constexpr float getNoteFrequency(NoteName note, int octave)
+    {
+        return OCTAVE_0_FREQUENCIES[int(note)] * float(1 << octave);
+    }
+
+protected:
+    /// @brief Only backends can be constructed.
+    StaticToneDriver() = default;
+
+    /// @brief Non-virtual: a backend is never deleted through a StaticToneDriver pointer.
+    ~StaticToneDriver() = default;
+
+private:
+    /// @brief The derived backend.
+    Backend& backend()
+    {
+        return static_cast<Backend&>(*this);
+    }
+
+    /// @brief Equal-tempered frequencies of octave 0 (C0 to B0), relative to A4 = 440Hz.
+    static constexpr float OCTAVE_0_FREQUENCIES[12] = {
+        16.351598f, 17.323914f, 18.354048f, 19.445436f, 20.601722f, 21.826764f,
+        23.124651f, 24.499715f, 25.956544f, 27.500000f, 29.135235f, 30.867706f
+    };
+};
+
+#endif // STATIC_TONE_DRIVER_H
@@ -15,7 +15,9 @@
  * 
  * It provides a consistent API for both embedded systems and desktop environments.
  *
- * Concrete implementations (e.g., ToneDriverSDL2) must override all methods.
+ * Concrete implementations (e.g., ToneDriverSDL2) must override all pure virtual methods.
+ * playChord() and playSequence() have defaults built on playNote(), playArpeggio() and
+ * rest(), which backends that can schedule a whole chord or run should override.
  */
 class ToneDriver 
 {
@@ -61,9 +63,38 @@ public:
      * @param octaves  Array of octave values corresponding to each note.
      * @param count    Number of notes (1 to MAX_POLYPHONY).
      * 
-     * @note The actual implementation may simulate chords as fast arpeggios.
+     * @note The actual implementation may simulate chords as fast arpeggios. The default
+     *       plays the notes once as a fast arpeggio with playArpeggio().
      */
-    virtual void playChord(const NoteName notes[5], const int octaves[5], int count) = 0;
+    virtual void playChord(const NoteName notes[5], const int octaves[5], int count)
+    {
+        playArpeggio(notes, octaves, count, DEFAULT_CHORD_ARPEGGIO_DELAY_MS);
+    }
+
+    /**
+     * @brief Play a chord consisting of up to MAX_POLYPHONY notes for a specific duration.
+     * 
+     * @param notes    Array of notes to play.
+     * @param octaves  Array of octave values corresponding to each note.
+     * @param count    Number of notes (1 to MAX_POLYPHONY).
+     * @param durationMs Chord duration in milliseconds.
+     * 
+     * @note The actual implementation may simulate chords as fast arpeggios. The default
+     *       cycles through the notes with playNote() for the whole duration.
+     */
+    virtual void playChord(const NoteName notes[5], const int octaves[5], int count, int durationMs)
+    {
+        if (count < 1 || count > MAX_POLYPHONY)
+        {
+            return;
+        }
+
+        for (int elapsedMs = 0, i = 0; elapsedMs < durationMs; elapsedMs += DEFAULT_CHORD_ARPEGGIO_DELAY_MS, i = (i + 1) % count)
+        {
+            int stepMs = (durationMs - elapsedMs < DEFAULT_CHORD_ARPEGGIO_DELAY_MS) ? durationMs - elapsedMs : DEFAULT_CHORD_ARPEGGIO_DELAY_MS;
+            playNote(notes[i], octaves[i], stepMs);
+        }
+    }
 
     /**
      * @brief Play a sequence of notes in succession to simulate an arpeggio.
@@ -76,6 +107,31 @@ public:
      */
     virtual void playArpeggio(const NoteName notes[5], const int octaves[5], int count, int noteDurationMs = DEFAULT_NOTE_DURATION_MS, int delayMs = DEFAULT_ARPEGGIO_DELAY_MS) = 0;
 
+    /**
+     * @brief Play a run of notes back to back, each followed by a rest.
+     * 
+     * @param notes    Array of notes to play.
+     * @param octaves  Array of octave values corresponding to each note.
+     * @param count    Number of notes in the arrays.
+     * @param noteDurationMs Duration of each note in milliseconds.
+     * @param restMs   Silence after each note in milliseconds.
+     * 
+     * @note The whole run is submitted at once, so implementations can schedule it
+     *       sample-accurately instead of timing each note from the calling thread. The
+     *       default plays it note by note with playNote() and rest().
+     */
+    virtual void playSequence(const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            if (isValidNote(notes[i], octaves[i]))
+            {
+                playNote(notes[i], octaves[i], noteDurationMs);
+                rest(restMs);
+            }
+        }
+    }
+
     /**
      * @brief Immediately stop playing any current tone.
      */
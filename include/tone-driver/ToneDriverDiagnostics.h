@@ -0,0 +1,357 @@
+/// @file ToneDriverDiagnostics.h
+/// @brief Definition of the ToneDriverDiagnostics class which records driver errors without doing I/O on the play path.
+
+#ifndef TONE_DRIVER_DIAGNOSTICS_H
+#define TONE_DRIVER_DIAGNOSTICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+/**
+ * @enum DiagnosticCode
+ * @brief Errors that a ToneDriver can report.
+ */
+enum class DiagnosticCode : uint8_t {
+    InvalidNote,        ///< A note outside 0–11 (C to B).
+    InvalidOctave,      ///< An octave outside 0–MAX_OCTAVE.
+    InvalidNoteCount,   ///< A chord or arpeggio with too few or too many notes.
+    VoicePoolExhausted, ///< A note was dropped because every pre-allocated voice was in use.
+    WriteFailed,        ///< Writing audio to the output failed (the value is errno); later audio is discarded.
+    Count               ///< Number of codes (not an error).
+};
+
+/**
+ * @brief Converts a DiagnosticCode to a const char* string literal.
+ *
+ * @param code The DiagnosticCode value.
+ * @return A pointer to a string literal naming the code.
+ */
+inline const char* diagnosticCodeToString(DiagnosticCode code) {
+    switch (code) {
+        case DiagnosticCode::InvalidNote:       return "InvalidNote";
+        case DiagnosticCode::InvalidOctave:     return "InvalidOctave";
+        case DiagnosticCode::InvalidNoteCount:  return "InvalidNoteCount";
+        case DiagnosticCode::VoicePoolExhausted: return "VoicePoolExhausted";
+        case DiagnosticCode::WriteFailed:       return "WriteFailed";
+        default:                                return "?";
+    }
+}
+
+
+/**
+ * @class ToneDriverDiagnostics
+ * @brief Records errors as counters plus a small fixed-size, rate-limited log.
+ *
+ * report() is lock-free and allocation-free, and never touches a stream, so it is cheap
+ * enough to call from paths a game runs every frame. Every report increments a counter;
+ * at most MAX_LOGGED_PER_SECOND reports of each code per second are also kept in the log,
+ * and the rest only counted. The log is formatted and written out by drain(), which should
+ * be called off the hot path (e.g. once per second or at shutdown).
+ *
+ * So that errors are not lost by default, the drivers call flush() after each blocking call
+ * and when they are destroyed, which drains the log to std::cerr. Use setOutput() to send it
+ * elsewhere, or to nullptr to leave it for drain().
+ *
+ * report() may be called from any number of threads. drain() and flush() may be too, but
+ * only one drains at a time.
+ */
+class ToneDriverDiagnostics
+{
+public:
+    /**
+     * @brief One logged error.
+     */
+    struct Entry
+    {
+        DiagnosticCode code;    ///< What went wrong.
+        int value;              ///< The offending value (note, octave or count).
+        int limit;              ///< The largest valid value, for the message.
+    };
+
+    /** @brief Constructor. All counters start at zero and the log is empty. */
+    ToneDriverDiagnostics()
+    {
+        for (size_t i = 0; i < LOG_CAPACITY; ++i)
+        {
+            log_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Records an error. Lock-free, allocation-free and never does I/O.
+     *
+     * @param code  What went wrong.
+     * @param value The offending value.
+     * @param limit The largest valid value, for the message.
+     */
+    void report(DiagnosticCode code, int value, int limit)
+    {
+        size_t index = size_t(code);
+        if (index >= CODE_COUNT) return;
+
+        counts_[index].fetch_add(1, std::memory_order_relaxed);
+
+        if (!withinRateLimit(index) || !push(Entry{code, value, limit}))
+        {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Writes and removes every logged error. Call off the hot path.
+     *
+     * @param out Stream to write one line per error to.
+     * @return The number of errors written.
+     */
+    int drain(std::ostream& out)
+    {
+        while (draining_.exchange(true, std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+
+        int written = drainLocked(out);
+        draining_.store(false, std::memory_order_release);
+        return written;
+    }
+
+    /**
+     * @brief Drains the log to the stream set by setOutput(). Called by the drivers off the hot path.
+     *
+     * Does nothing if there is no output stream or another thread is already draining.
+     *
+     * @return The number of errors written.
+     */
+    int flush()
+    {
+        std::ostream* out = output_.load(std::memory_order_relaxed);
+        if (out == nullptr || draining_.exchange(true, std::memory_order_acquire))
+        {
+            return 0;
+        }
+
+        int written = drainLocked(*out);
+        draining_.store(false, std::memory_order_release);
+        return written;
+    }
+
+    /**
+     * @brief Sets the stream that flush() writes to.
+     *
+     * @param out The stream (std::cerr by default), or nullptr to keep errors until drain() is called.
+     */
+    void setOutput(std::ostream* out)
+    {
+        output_.store(out, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the number of times an error has been reported.
+     *
+     * @param code The error.
+     * @return The count since construction or the last resetCounts().
+     */
+    uint64_t getErrorCount(DiagnosticCode code) const
+    {
+        size_t index = size_t(code);
+        return (index < CODE_COUNT) ? counts_[index].load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+     * @brief Gets the number of errors reported across all codes.
+     *
+     * @return The total count.
+     */
+    uint64_t getTotalErrorCount() const
+    {
+        uint64_t total = 0;
+        for (size_t i = 0; i < CODE_COUNT; ++i)
+        {
+            total += counts_[i].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /** @brief Resets every error counter to zero. The log is left as is. */
+    void resetCounts()
+    {
+        for (size_t i = 0; i < CODE_COUNT; ++i)
+        {
+            counts_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static constexpr size_t LOG_CAPACITY = 64;          ///< Maximum number of undrained log entries (power of two).
+    static constexpr uint32_t MAX_LOGGED_PER_SECOND = 10; ///< Log entries kept per code per second; the rest are only counted.
+
+private:
+    static constexpr size_t CODE_COUNT = size_t(DiagnosticCode::Count);
+
+    /**
+     * @struct Slot
+     * @brief A log slot with a sequence number (bounded multi-producer queue).
+     */
+    struct Slot
+    {
+        std::atomic<size_t> sequence;   ///< Tells producers and the consumer whose turn the slot is.
+        Entry entry;                    ///< The logged error.
+    };
+
+    /**
+     * @brief Checks and updates the per-second budget of a code.
+     *
+     * @param index Index of the code.
+     * @return true if the report should be logged.
+     */
+    bool withinRateLimit(size_t index)
+    {
+        uint32_t second = uint32_t(std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+
+        uint32_t windowStart = windowStart_[index].load(std::memory_order_relaxed);
+        if (windowStart != second && windowStart_[index].compare_exchange_strong(windowStart, second, std::memory_order_relaxed))
+        {
+            windowCount_[index].store(0, std::memory_order_relaxed);
+        }
+
+        return windowCount_[index].fetch_add(1, std::memory_order_relaxed) < MAX_LOGGED_PER_SECOND;
+    }
+
+    /**
+     * @brief Adds an entry to the log (any thread).
+     *
+     * @param entry The entry to add.
+     * @return false if the log is full.
+     */
+    bool push(const Entry& entry)
+    {
+        size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            Slot& slot = log_[position & (LOG_CAPACITY - 1)];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t difference = intptr_t(sequence) - intptr_t(position);
+
+            if (difference == 0)
+            {
+                if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.entry = entry;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false; // Full
+            }
+            else
+            {
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the oldest entry from the log (draining thread only).
+     *
+     * @param entry Receives the entry.
+     * @return false if the log is empty.
+     */
+    bool pop(Entry& entry)
+    {
+        Slot& slot = log_[dequeuePosition_ & (LOG_CAPACITY - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+        if (intptr_t(sequence) - intptr_t(dequeuePosition_ + 1) < 0)
+        {
+            return false; // Empty
+        }
+
+        entry = slot.entry;
+        slot.sequence.store(dequeuePosition_ + LOG_CAPACITY, std::memory_order_release);
+        ++dequeuePosition_;
+        return true;
+    }
+
+    /**
+     * @brief Writes and removes every logged error (caller holds draining_).
+     *
+     * @param out Stream to write one line per error to.
+     * @return The number of errors written.
+     */
+    int drainLocked(std::ostream& out)
+    {
+        int written = 0;
+        Entry entry;
+
+        while (pop(entry))
+        {
+            writeEntry(out, entry);
+            ++written;
+        }
+
+        uint64_t suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        if (suppressed > 0)
+        {
+            out << suppressed << " further error(s) counted but not logged (rate limited)" << '\n';
+        }
+
+        if (written > 0 || suppressed > 0)
+        {
+            out.flush();
+        }
+
+        return written;
+    }
+
+    /**
+     * @brief Formats one entry as a human readable line.
+     *
+     * @param out Stream to write to.
+     * @param entry The entry.
+     */
+    static void writeEntry(std::ostream& out, const Entry& entry)
+    {
+        switch (entry.code)
+        {
+            case DiagnosticCode::InvalidNote:
+                out << entry.value << " is not a valid note! Notes range from 0 to " << entry.limit << " (C to B)" << '\n';
+                break;
+            case DiagnosticCode::InvalidOctave:
+                out << entry.value << " is not a valid octave! Octaves range from 0 to " << entry.limit << '\n';
+                break;
+            case DiagnosticCode::InvalidNoteCount:
+                out << entry.value << " is not a valid number of notes! Chords and arpeggios can have between 1 and " << entry.limit << " notes." << '\n';
+                break;
+            case DiagnosticCode::VoicePoolExhausted:
+                out << "A note was dropped: all " << entry.limit << " voices were in use" << '\n';
+                break;
+            case DiagnosticCode::WriteFailed:
+                out << "Audio output write failed: " << std::strerror(entry.value) << '\n';
+                break;
+            default:
+                out << diagnosticCodeToString(entry.code) << ": " << entry.value << '\n';
+                break;
+        }
+    }
+
+    std::atomic<uint64_t> counts_[CODE_COUNT] = {};         ///< Reports of each code.
+    std::atomic<uint32_t> windowStart_[CODE_COUNT] = {};    ///< Second in which each code's rate window started.
+    std::atomic<uint32_t> windowCount_[CODE_COUNT] = {};    ///< Reports of each code in the current window.
+    std::atomic<uint64_t> suppressed_{0};                   ///< Reports counted but not logged since the last drain.
+
+    Slot log_[LOG_CAPACITY];                                ///< Fixed-size ring of logged errors.
+    std::atomic<size_t> enqueuePosition_{0};                ///< Next slot to write (shared by producers).
+    size_t dequeuePosition_ = 0;                            ///< Next slot to read (draining thread only).
+    std::atomic<bool> draining_{false};                     ///< True while a thread is draining the log.
+    std::atomic<std::ostream*> output_{&std::cerr};         ///< Stream flush() writes to, or nullptr.
+};
+
+#endif // TONE_DRIVER_DIAGNOSTICS_H
@@ -0,0 +1,47 @@
+/// @file VirtualToneDriver.h
+/// @brief Definition of the VirtualToneDriver class template which exposes a StaticToneDriver backend through the ToneDriver interface.
+
+#ifndef VIRTUAL_TONE_DRIVER_H
+#define VIRTUAL_TONE_DRIVER_H
+
+#include "tone-driver/ToneDriver.h"
+#include "tone-driver/StaticToneDriver.h"
+
+/**
+ * @class VirtualToneDriver
+ * @brief Wraps a StaticToneDriver backend as a ToneDriver so it can be chosen at runtime.
+ *
+ * Each virtual call forwards to the backend, where the rest of the call chain is still
+ * statically dispatched. Only code that needs runtime selection pays for the vtable.
+ *
+ * @tparam Backend A class deriving from StaticToneDriver<Backend>.
+ */
+template <typename Backend>
+class VirtualToneDriver : public ToneDriver
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param backend The backend to forward to (must outlive this object).
+     */
+    explicit VirtualToneDriver(Backend& backend) : backend(backend) {}
+
+    void playFrequency(float freq) override { backend.playFrequency(freq); }
+    void playFrequency(float freq, int durationMs) override { backend.playFrequency(freq, durationMs); }
+    void playNote(NoteName note, int octave) override { backend.playNote(note, octave); }
+    void playNote(NoteName note, int octave, int durationMs) override { backend.playNote(note, octave, durationMs); }
+    void playChord(const NoteName notes[5], const int octaves[5], int count) override { backend.playChord(notes, octaves, count); }
+    void playChord(const NoteName notes[5], const int octaves[5], int count, int durationMs) override { backend.playChord(notes, octaves, count, durationMs); }
+    void playArpeggio(const NoteName notes[5], const int octaves[5], int count, int noteDurationMs = DEFAULT_NOTE_DURATION_MS, int delayMs = DEFAULT_ARPEGGIO_DELAY_MS) override { backend.playArpeggio(notes, octaves, count, noteDurationMs, delayMs); }
+    void playSequence(const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs) override { backend.playSequence(notes, octaves, count, noteDurationMs, restMs); }
+    void stop() override { backend.stop(); }
+    void stopAfter(int durationMs) override { backend.stopAfter(durationMs); }
+    void rest(int durationMs) override { backend.rest(durationMs); }
+    bool isValidNote(NoteName note, int octave) override { return backend.isValidNote(note, octave); }
+
+private:
+    Backend& backend;   ///< The statically dispatched backend.
+};
+
+#endif // VIRTUAL_TONE_DRIVER_H
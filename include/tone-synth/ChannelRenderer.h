@@ -0,0 +1,174 @@
+/// @file ChannelRenderer.h
+/// @brief Definition of the ChannelRenderer class which renders many independent square wave channels in one pass.
+
+#ifndef CHANNEL_RENDERER_H
+#define CHANNEL_RENDERER_H
+
+#include <stdint.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "NoteName.h"
+
+/**
+ * @class ChannelRenderer
+ * @brief Renders thousands of independent square wave channels, each into its own output buffer.
+ *
+ * Oscillator state for every channel is kept in a structure-of-arrays layout (one array of
+ * phases, one of phase increments, one of amplitudes) instead of one ToneDriverSDL2 per channel.
+ * Each channel is a 32-bit fixed-point phase accumulator. With AVX2 or SSE2, eight channels
+ * are rendered at once, one per lane, loaded straight from the arrays; each block of eight
+ * samples is transposed into the channels' own buffers. Channels and samples left over are
+ * rendered one channel at a time.
+ *
+ * Channels can be partitioned across worker threads, one contiguous range per thread.
+ */
+class ChannelRenderer
+{
+public:
+    /**
+     * @brief Constructor. Allocates state for all channels, initially silent.
+     * 
+     * @param channelCount Number of channels.
+     * @param sampleRate   Output sample rate in Hz.
+     */
+    ChannelRenderer(int channelCount, int sampleRate = DEFAULT_SAMPLE_RATE);
+
+    /** @brief Destructor. Stops any worker threads. */
+    ~ChannelRenderer();
+
+    ChannelRenderer(const ChannelRenderer&) = delete;
+    ChannelRenderer& operator=(const ChannelRenderer&) = delete;
+
+    /**
+     * @brief Set the frequency of a channel.
+     * 
+     * @param channel Channel index.
+     * @param freq    Frequency in Hertz (0 holds the output at a constant level).
+     */
+    void setFrequency(int channel, float freq);
+
+    /**
+     * @brief Set the frequency of a channel from a note and octave.
+     * 
+     * @param channel Channel index.
+     * @param note    Note (0–11).
+     * @param octave  Octave number (0–6).
+     */
+    void setNote(int channel, NoteName note, int octave);
+
+    /**
+     * @brief Set the amplitude (volume) of a channel.
+     * 
+     * @param channel   Channel index.
+     * @param amplitude Float from 0.0 to 1.0.
+     */
+    void setAmplitude(int channel, float amplitude);
+
+    /**
+     * @brief Silence a channel and reset its phase.
+     * 
+     * @param channel Channel index.
+     */
+    void stop(int channel);
+
+    /**
+     * @brief Set the number of threads used by render(). Channels are split evenly between them.
+     * 
+     * @param threadCount Number of threads (1 renders on the calling thread only).
+     */
+    void setThreadCount(int threadCount);
+
+    /**
+     * @brief Render every channel into its own output buffer.
+     * 
+     * @param outputs Array of getChannelCount() buffers, each at least `samples` long.
+     * @param samples Number of mono 16-bit samples to render per channel.
+     */
+    void render(int16_t* const outputs[], int samples);
+
+    /**
+     * @brief Render a contiguous range of channels on the calling thread.
+     * 
+     * @param outputs      Array of getChannelCount() buffers, indexed by channel.
+     * @param samples      Number of samples to render per channel.
+     * @param firstChannel First channel to render (inclusive).
+     * @param endChannel   Last channel to render (exclusive).
+     */
+    void renderRange(int16_t* const outputs[], int samples, int firstChannel, int endChannel);
+
+    /** @brief Gets the number of channels. */
+    int getChannelCount() const;
+
+    /** @brief Gets the output sample rate in Hz. */
+    int getSampleRate() const;
+
+    /** @brief Gets the number of threads used by render(). */
+    int getThreadCount() const;
+
+    /** @brief Gets the name of the instruction set used for rendering ("AVX2", "SSE2" or "scalar"). */
+    static const char* getInstructionSet();
+
+    static constexpr int DEFAULT_SAMPLE_RATE = 44100;   ///< Default output sample rate in Hz.
+
+private:
+    /**
+     * @brief Render one channel with the widest instruction set available.
+     *
+     * @param channel Channel index.
+     * @param output  Buffer to write to.
+     * @param samples Number of samples to render.
+     */
+    void renderChannel(int channel, int16_t* output, int samples);
+
+    /**
+     * @brief Render GROUP_CHANNELS consecutive channels together, one per SIMD lane.
+     *
+     * @param outputs      Array of getChannelCount() buffers, indexed by channel.
+     * @param samples      Number of samples to render per channel.
+     * @param firstChannel First of the channels.
+     */
+    void renderGroup(int16_t* const outputs[], int samples, int firstChannel);
+
+    /**
+     * @brief Worker thread loop. Waits for a render job and renders its share of the channels.
+     *
+     * @param worker Index of the worker (1 to threadCount - 1; the calling thread is worker 0).
+     */
+    void workerLoop(int worker);
+
+    /** @brief Stops and joins all worker threads. */
+    void stopWorkers();
+
+    /**
+     * @brief Computes the channel range rendered by a worker.
+     *
+     * @param worker Index of the worker.
+     * @param first  Receives the first channel (inclusive).
+     * @param end    Receives the last channel (exclusive).
+     */
+    void getPartition(int worker, int& first, int& end) const;
+
+    static constexpr int GROUP_CHANNELS = 8; ///< Channels rendered together by renderGroup() (and samples per transposed block).
+
+    int channelCount_;                  ///< Number of channels.
+    int sampleRate_;                    ///< Output sample rate in Hz.
+
+    std::vector<uint32_t> phase_;       ///< Fixed-point phase of each channel (2^32 = one cycle).
+    std::vector<uint32_t> increment_;   ///< Phase increment per sample of each channel.
+    std::vector<int32_t> amplitude_;    ///< Peak output level of each channel (0 to 32767).
+
+    int threadCount_ = 1;                   ///< Number of threads sharing a render.
+    std::vector<std::thread> workers_;      ///< Worker threads (threadCount_ - 1 of them).
+    std::mutex jobMutex_;                   ///< Guards the job fields below.
+    std::condition_variable jobReady_;      ///< Signalled when a new render job is posted.
+    std::condition_variable jobDone_;       ///< Signalled when a worker finishes its share.
+    unsigned jobGeneration_ = 0;            ///< Incremented for every render job.
+    int jobPending_ = 0;                    ///< Workers still rendering the current job.
+    bool stopping_ = false;                 ///< Tells the workers to exit.
+    int16_t* const* jobOutputs_ = nullptr;  ///< Output buffers of the current job.
+    int jobSamples_ = 0;                    ///< Samples per channel of the current job.
+};
+
+#endif // CHANNEL_RENDERER_H
@@ -0,0 +1,115 @@
+/// @file NoiseVoice.h
+/// @brief Definition of the NoiseVoice class which generates pitched LFSR noise with a decay envelope, for percussion.
+
+#ifndef NOISE_VOICE_H
+#define NOISE_VOICE_H
+
+#include <stdint.h>
+
+/**
+ * @enum NoiseMode
+ * @brief Sequence length of the noise shift register.
+ */
+enum class NoiseMode {
+    Long,   ///< 32767-step sequence (taps 0 and 1): hiss, for snares, hi-hats and cymbals.
+    Short   ///< 93-step sequence (taps 0 and 6): a buzzy, metallic tone.
+};
+
+/**
+ * @enum NoiseDecay
+ * @brief Shape of a noise hit's fade to silence.
+ */
+enum class NoiseDecay {
+    Linear,         ///< Falls in a straight line to silence at the end of the hit.
+    Exponential,    ///< Falls quickly then tails off, like a struck drum (about -40 dB by the end of the hit).
+    None            ///< Full level until the end of the hit.
+};
+
+/**
+ * @struct NoiseHit
+ * @brief One percussion hit: how the noise is clocked and how long it takes to die away.
+ */
+struct NoiseHit
+{
+    float clockHz = 8000.0f;                    ///< Shift register clock: higher is brighter.
+    NoiseMode mode = NoiseMode::Long;           ///< Sequence length.
+    NoiseDecay decay = NoiseDecay::Exponential; ///< Envelope shape.
+    int durationMs = 150;                       ///< Length of the hit in milliseconds.
+    float level = 1.0f;                         ///< Peak level (0.0 to 1.0).
+};
+
+/// @brief A snare drum: mid-bright hiss with a short exponential decay.
+constexpr NoiseHit noiseSnare() { return NoiseHit{8000.0f, NoiseMode::Long, NoiseDecay::Exponential, 180, 0.9f}; }
+
+/// @brief A closed hi-hat: very bright and very short.
+constexpr NoiseHit noiseHiHat() { return NoiseHit{44100.0f, NoiseMode::Long, NoiseDecay::Exponential, 50, 0.6f}; }
+
+/// @brief A crash cymbal: bright hiss with a long tail.
+constexpr NoiseHit noiseCrash() { return NoiseHit{30000.0f, NoiseMode::Long, NoiseDecay::Exponential, 900, 0.7f}; }
+
+/// @brief A low drum: dull noise falling away in a straight line.
+constexpr NoiseHit noiseTom() { return NoiseHit{1500.0f, NoiseMode::Long, NoiseDecay::Linear, 200, 1.0f}; }
+
+/// @brief A metallic clank from the short sequence.
+constexpr NoiseHit noiseClank() { return NoiseHit{12000.0f, NoiseMode::Short, NoiseDecay::Exponential, 120, 0.7f}; }
+
+
+/**
+ * @class NoiseVoice
+ * @brief A 15-bit linear-feedback shift register noise generator, in the style of the noise channel of classic consoles.
+ *
+ * The register is clocked by its own fixed-point phase accumulator (2^32 = one clock), so the
+ * clock rate sets the pitch of the noise and can be anywhere from a low rumble to several steps
+ * per sample. The output is the register's low bit as a full-scale square, scaled by an
+ * integer decay envelope. Everything per sample is integer arithmetic: no rand(), no floating
+ * point. Like Voice, a NoiseVoice holds no pointers and never allocates, so it can live in a
+ * RealtimePool inside an audio callback.
+ */
+class NoiseVoice
+{
+public:
+    /**
+     * @brief Start a hit.
+     *
+     * @param hit        Clock, mode, decay and level of the hit.
+     * @param samples    Length of the hit in samples (the envelope spans this length).
+     * @param sampleRate Output sample rate in Hz.
+     */
+    void start(const NoiseHit& hit, uint32_t samples, int sampleRate);
+
+    /** @brief Silence the voice. */
+    void stop();
+
+    /**
+     * @brief Generate the next sample.
+     *
+     * @return Sample from -32767 to 32767, or 0 once the hit has ended.
+     */
+    int16_t nextSample();
+
+    /** @brief Checks whether the voice is sounding. */
+    bool isActive() const;
+
+    /** @brief Gets the shift register (15 bits). */
+    uint16_t getRegister() const;
+
+    static constexpr uint16_t REGISTER_SEED = 1;        ///< Register value at the start of every hit.
+    static constexpr uint32_t MAX_STEPS_PER_SAMPLE = 16; ///< Clock rate limit, in register steps per output sample.
+
+private:
+    /** @brief Moves the shift register on one step. */
+    void clock();
+
+    bool active_ = false;               ///< True while the voice is sounding.
+    uint16_t register_ = REGISTER_SEED; ///< The 15-bit shift register.
+    int tap_ = 1;                       ///< Bit XORed with bit 0 for the feedback (1 long, 6 short).
+    uint64_t phase_ = 0;                ///< Clock phase (2^32 = one register step).
+    uint64_t increment_ = 0;            ///< Clock phase increment per sample.
+    NoiseDecay decay_ = NoiseDecay::None; ///< Envelope shape.
+    uint32_t level_ = 0;                ///< Envelope level (32767 << 16 = full scale).
+    uint32_t linearStep_ = 0;           ///< Level lost per sample (NoiseDecay::Linear).
+    int decayShift_ = 0;                ///< Level lost per sample is level >> decayShift_ (NoiseDecay::Exponential).
+    uint32_t remaining_ = 0;            ///< Samples left in the hit.
+};
+
+#endif // NOISE_VOICE_H
@@ -0,0 +1,98 @@
+/// @file RealtimeGuard.h
+/// @brief Definition of the RealtimeGuard class which catches allocation and locking on the audio thread.
+
+#ifndef REALTIME_GUARD_H
+#define REALTIME_GUARD_H
+
+#include <stdint.h>
+
+/**
+ * @enum RealtimeViolation
+ * @brief Operations that must not happen inside an audio callback.
+ */
+enum class RealtimeViolation : uint8_t {
+    Allocation,     ///< malloc, calloc, realloc or operator new.
+    Deallocation,   ///< free or operator delete.
+    Lock,           ///< Locking a mutex.
+    Count           ///< Number of violation types (not a violation).
+};
+
+/**
+ * @brief Converts a RealtimeViolation to a const char* string literal.
+ *
+ * @param violation The RealtimeViolation value.
+ * @return A pointer to a string literal naming the violation.
+ */
+inline const char* realtimeViolationToString(RealtimeViolation violation) {
+    switch (violation) {
+        case RealtimeViolation::Allocation:     return "Allocation";
+        case RealtimeViolation::Deallocation:   return "Deallocation";
+        case RealtimeViolation::Lock:           return "Lock";
+        default:                                return "?";
+    }
+}
+
+
+/**
+ * @class RealtimeGuard
+ * @brief Marks the current thread as real-time for the lifetime of the guard.
+ *
+ * Construct one at the top of an audio callback. In builds configured with
+ * `-DTONE_DRIVER_RT_CHECKS=ON`, every allocation, deallocation and mutex lock made while a
+ * guard is alive on the same thread is counted, so a test can play audio and then check
+ * that getTotalViolationCount() is still zero. On Linux malloc, free and pthread_mutex_lock
+ * are intercepted with the linker; elsewhere only operator new and delete are.
+ *
+ * In normal builds the guard compiles to nothing and the counters are always zero.
+ */
+class RealtimeGuard
+{
+public:
+#ifdef TONE_DRIVER_RT_CHECKS
+    /** @brief Enters a real-time section on this thread. */
+    RealtimeGuard();
+
+    /** @brief Leaves the real-time section. */
+    ~RealtimeGuard();
+#else
+    RealtimeGuard() {}
+    ~RealtimeGuard() {}
+#endif
+
+    RealtimeGuard(const RealtimeGuard&) = delete;
+    RealtimeGuard& operator=(const RealtimeGuard&) = delete;
+
+    /**
+     * @brief Checks whether this build counts violations.
+     *
+     * @return true if built with TONE_DRIVER_RT_CHECKS.
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief Checks whether the calling thread is inside a guard.
+     *
+     * @return true between a guard's construction and destruction on this thread.
+     */
+    static bool isActive();
+
+    /**
+     * @brief Gets the number of violations of one type seen inside a guard.
+     *
+     * @param violation The type of violation.
+     * @return The count since startup or the last resetViolations().
+     */
+    static uint64_t getViolationCount(RealtimeViolation violation);
+
+    /**
+     * @brief Gets the number of violations of every type seen inside a guard.
+     *
+     * @return The total count.
+     */
+    static uint64_t getTotalViolationCount();
+
+    /** @brief Resets every violation counter to zero. */
+    static void resetViolations();
+};
+
+#endif // REALTIME_GUARD_H
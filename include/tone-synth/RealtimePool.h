@@ -0,0 +1,86 @@
+/// @file RealtimePool.h
+/// @brief Definition of the RealtimePool class which hands out objects from storage allocated once.
+
+#ifndef REALTIME_POOL_H
+#define REALTIME_POOL_H
+
+#include <stddef.h>
+#include <memory>
+
+/**
+ * @class RealtimePool
+ * @brief A fixed-size pool of objects for use on the audio thread.
+ *
+ * All storage is allocated by the constructor. acquire() and release() only move an index
+ * on and off a free list, so they never allocate, lock or do I/O and are safe to call from
+ * an audio callback. When the pool is empty acquire() returns nullptr rather than growing.
+ *
+ * A pool is not thread safe: it should only be used by the thread that renders audio.
+ *
+ * @tparam T Object type. Must be default constructible and copy assignable.
+ */
+template <typename T>
+class RealtimePool
+{
+public:
+    /**
+     * @brief Constructor. Allocates every object the pool will ever hand out.
+     *
+     * @param capacity Maximum number of objects in use at once.
+     */
+    explicit RealtimePool(size_t capacity)
+        : items_(new T[capacity]), freeList_(new size_t[capacity]), capacity_(capacity), freeCount_(capacity)
+    {
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+            freeList_[i] = capacity_ - 1 - i; // Hand out the first object first
+        }
+    }
+
+    RealtimePool(const RealtimePool&) = delete;
+    RealtimePool& operator=(const RealtimePool&) = delete;
+
+    /**
+     * @brief Takes an object from the pool, reset to its default state.
+     *
+     * @return The object, or nullptr if every object is in use.
+     */
+    T* acquire()
+    {
+        if (freeCount_ == 0)
+        {
+            return nullptr;
+        }
+
+        T* item = &items_[freeList_[--freeCount_]];
+        *item = T();
+        return item;
+    }
+
+    /**
+     * @brief Returns an object to the pool.
+     *
+     * @param item An object from acquire() (nullptr is ignored).
+     */
+    void release(T* item)
+    {
+        if (item != nullptr)
+        {
+            freeList_[freeCount_++] = size_t(item - items_.get());
+        }
+    }
+
+    /** @brief Gets the number of objects the pool holds. */
+    size_t getCapacity() const { return capacity_; }
+
+    /** @brief Gets the number of objects not currently in use. */
+    size_t getAvailable() const { return freeCount_; }
+
+private:
+    std::unique_ptr<T[]> items_;            ///< Every object in the pool.
+    std::unique_ptr<size_t[]> freeList_;    ///< Indices of the objects not in use (a stack).
+    size_t capacity_;                       ///< Number of objects in the pool.
+    size_t freeCount_;                      ///< Number of indices on the free list.
+};
+
+#endif // REALTIME_POOL_H
@@ -0,0 +1,101 @@
+/// @file SegmentedRenderer.h
+/// @brief Definition of the SegmentedRenderer class which renders a long song in parallel time segments.
+
+#ifndef SEGMENTED_RENDERER_H
+#define SEGMENTED_RENDERER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "tone-synth/StaticSong.h"
+
+/**
+ * @enum PhaseMode
+ * @brief What happens to the oscillator phase at the start of each note.
+ */
+enum class PhaseMode {
+    Continuous,     ///< The phase carries on from the previous note (one oscillator for the whole song).
+    ResetPerNote    ///< Every note starts from phase zero (matches StaticSong and renderSongNote()).
+};
+
+/**
+ * @class SegmentedRenderer
+ * @brief Renders a song offline by splitting it into time segments and rendering them concurrently.
+ *
+ * The oscillator is a 32-bit fixed-point phase accumulator, so the phase at any sample is the
+ * sum of every earlier increment modulo 2^32. The constructor computes the phase at the start
+ * of each note (increment × length per note, added up with wrapping arithmetic), and any
+ * segment can then start from the phase at its first sample without rendering what came
+ * before. The stitched result is therefore bit-identical to renderSerial().
+ *
+ * Rests hold the phase where it is.
+ */
+class SegmentedRenderer
+{
+public:
+    /**
+     * @brief Constructor. Lays out the song and computes the phase at the start of every note.
+     *
+     * @param notes      The song. Notes outside the valid range are rendered as rests.
+     * @param mode       Whether the phase carries on between notes.
+     * @param sampleRate Output sample rate in Hz.
+     * @param amplitude  Peak output level (0 to 32767).
+     */
+    SegmentedRenderer(const std::vector<SongNote>& notes, PhaseMode mode = PhaseMode::Continuous,
+                      int sampleRate = DEFAULT_SAMPLE_RATE, int amplitude = DEFAULT_AMPLITUDE);
+
+    /**
+     * @brief Renders the whole song one sample after another on the calling thread (the reference).
+     *
+     * @param out Receives getSampleCount() samples.
+     */
+    void renderSerial(int16_t* out) const;
+
+    /**
+     * @brief Renders the whole song as segments on several threads.
+     *
+     * @param out         Receives getSampleCount() samples.
+     * @param threadCount Number of threads (0 uses every hardware thread).
+     */
+    void render(int16_t* out, unsigned threadCount = 0) const;
+
+    /**
+     * @brief Renders part of the song, starting from the analytic phase at its first sample.
+     *
+     * @param first Index of the first sample.
+     * @param count Number of samples.
+     * @param out   Receives the samples.
+     */
+    void renderRange(size_t first, size_t count, int16_t* out) const;
+
+    /**
+     * @brief Gets the oscillator phase at a sample without rendering.
+     *
+     * @param sample Sample index.
+     * @return Phase as a 32-bit fraction of a cycle.
+     */
+    uint32_t getPhaseAt(size_t sample) const;
+
+    /** @brief Gets the length of the song in samples. */
+    size_t getSampleCount() const;
+
+    static constexpr int DEFAULT_SAMPLE_RATE = 44100;   ///< Default output sample rate in Hz.
+    static constexpr int DEFAULT_AMPLITUDE = 16384;     ///< Default peak output level.
+    static constexpr size_t SEGMENT_ALIGNMENT = 32;     ///< Segments start on multiples of this many samples (one cache line).
+
+private:
+    /**
+     * @brief Finds the note playing at a sample.
+     *
+     * @param sample Sample index (less than getSampleCount()).
+     * @return Index of the note.
+     */
+    size_t findNote(size_t sample) const;
+
+    int amplitude_;                     ///< Peak output level.
+    std::vector<size_t> offsets_;       ///< First sample of each note, plus the total length at the end.
+    std::vector<uint32_t> increments_;  ///< Phase increment of each note (0 for rests).
+    std::vector<uint32_t> startPhases_; ///< Phase at the first sample of each note.
+};
+
+#endif // SEGMENTED_RENDERER_H
@@ -0,0 +1,57 @@
+/// @file SongFile.h
+/// @brief Functions to read songs from text files and render them to PCM at runtime.
+
+#ifndef SONG_FILE_H
+#define SONG_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <istream>
+#include <vector>
+#include "tone-synth/StaticSong.h"
+
+/**
+ * @brief Parses one line of a song file.
+ *
+ * A line is a note and octave followed by a duration in milliseconds (e.g. `C#4 250`,
+ * `Bb3 125`), or `R` followed by a duration for a rest (e.g. `R 100`). Note letters may be
+ * upper or lower case and take a `#` or `b` accidental.
+ *
+ * @param text The line, without the trailing newline.
+ * @param note Receives the note.
+ * @return true if the line is a valid note or rest.
+ */
+bool parseSongNote(const char* text, SongNote& note);
+
+/**
+ * @brief Reads a song, one note or rest per line. Blank lines and lines starting with `#` are skipped.
+ *
+ * @param in    Stream to read from.
+ * @param notes Receives the notes (cleared first).
+ * @return 0 on success, otherwise the number of the first invalid line (1-based).
+ */
+int parseSong(std::istream& in, std::vector<SongNote>& notes);
+
+/**
+ * @brief Checks whether two song notes sound the same.
+ *
+ * @param a The first note.
+ * @param b The second note.
+ * @return true if both render to the same samples.
+ */
+bool isSameSongNote(const SongNote& a, const SongNote& b);
+
+/**
+ * @brief Renders one note of a song as a square wave, exactly as StaticSong does at compile time.
+ *
+ * Each note starts from phase zero, so a note always renders to the same samples wherever
+ * it is in the song. That lets an edited song be re-rendered a note at a time.
+ *
+ * @param note       The note or rest.
+ * @param sampleRate Output sample rate in Hz.
+ * @param amplitude  Peak output level (0 to 32767).
+ * @param out        Receives staticSongNoteSamples(note, sampleRate) samples.
+ */
+void renderSongNote(const SongNote& note, int sampleRate, int amplitude, int16_t* out);
+
+#endif // SONG_FILE_H
@@ -0,0 +1,190 @@
+/// @file StaticSong.h
+/// @brief Definition of the StaticSong template which renders a short sequence to PCM at compile time.
+
+#ifndef STATIC_SONG_H
+#define STATIC_SONG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+#include <iterator>     // for std::size
+#include "NoteName.h"
+
+/**
+ * @struct SongNote
+ * @brief One note (or rest) of a compile-time song.
+ */
+struct SongNote
+{
+    NoteName note;          ///< Pitch class of the note.
+    int octave;             ///< Octave of the note (0–6).
+    int durationMs;         ///< Duration in milliseconds.
+    bool isRest = false;    ///< True if this is a silence rather than a note.
+
+    /**
+     * @brief Creates a rest.
+     *
+     * @param durationMs Duration of the silence in milliseconds.
+     * @return A SongNote that renders as silence.
+     */
+    static constexpr SongNote rest(int durationMs)
+    {
+        return SongNote{NoteName::C, 0, durationMs, true};
+    }
+};
+
+
+static constexpr int STATIC_SONG_MAX_OCTAVE = 6;        ///< Maximum octave index supported (inclusive).
+static constexpr size_t STATIC_SONG_MAX_SAMPLES = size_t(1) << 18; ///< Longest song that can be rendered at compile time.
+
+/**
+ * @brief Checks that every note of a song has a valid pitch class, octave and duration.
+ *
+ * @param notes The song.
+ * @return true if every note is valid.
+ */
+template <size_t N>
+constexpr bool isValidStaticSong(const SongNote (&notes)[N])
+{
+    for (size_t i = 0; i < N; ++i)
+    {
+        const SongNote& n = notes[i];
+        if (n.durationMs <= 0) return false;
+        if (n.isRest) continue;
+        if (n.note < NoteName::C || n.note > NoteName::B) return false;
+        if (n.octave < 0 || n.octave > STATIC_SONG_MAX_OCTAVE) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Number of samples a note lasts for.
+ *
+ * @param note The note.
+ * @param sampleRate Output sample rate in Hz.
+ * @return Duration in samples.
+ */
+constexpr size_t staticSongNoteSamples(const SongNote& note, int sampleRate)
+{
+    return (size_t(note.durationMs) * sampleRate) / 1000;
+}
+
+/**
+ * @brief Total number of samples in a song.
+ *
+ * @param notes The song.
+ * @param sampleRate Output sample rate in Hz.
+ * @return Sum of the sample lengths of every note.
+ */
+template <size_t N>
+constexpr size_t countStaticSongSamples(const SongNote (&notes)[N], int sampleRate)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < N; ++i)
+    {
+        total += staticSongNoteSamples(notes[i], sampleRate);
+    }
+    return total;
+}
+
+/**
+ * @brief Phase increment per sample of a note, as a 32-bit fixed-point fraction of a cycle.
+ *
+ * @param note The note.
+ * @param sampleRate Output sample rate in Hz.
+ * @return Phase increment (2^32 = one cycle).
+ */
+constexpr uint32_t staticSongPhaseIncrement(const SongNote& note, int sampleRate)
+{
+    // 2^(n/12) for n = -9 (C) to 2 (B), relative to A4 = 440Hz
+    constexpr double SEMITONE_RATIOS[12] = {
+        0.5946035575013605, 0.6299605249474366, 0.6674199270850172, 0.7071067811865476,
+        0.7491535384383408, 0.7937005259840998, 0.8408964152537145, 0.8908987181403393,
+        0.9438743126816935, 1.0,                1.0594630943592953, 1.1224620483093730
+    };
+
+    double freq = 440.0 * SEMITONE_RATIOS[int(note.note)];
+    for (int octave = 4; octave < note.octave; ++octave) freq *= 2.0;
+    for (int octave = 4; octave > note.octave; --octave) freq /= 2.0;
+
+    return uint32_t((freq / sampleRate) * 4294967296.0 + 0.5);
+}
+
+/**
+ * @brief Renders a song to square wave PCM. Evaluated by the compiler to initialise StaticSong::pcm.
+ *
+ * @tparam Samples Number of samples to render (from countStaticSongSamples()).
+ * @param notes The song.
+ * @param sampleRate Output sample rate in Hz.
+ * @param amplitude Peak output level (0 to 32767).
+ * @return The rendered samples.
+ */
+template <size_t Samples, size_t N>
+constexpr std::array<int16_t, Samples> renderStaticSong(const SongNote (&notes)[N], int sampleRate, int amplitude)
+{
+    std::array<int16_t, Samples> samples{};
+    size_t position = 0;
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        const SongNote& note = notes[i];
+        const size_t length = staticSongNoteSamples(note, sampleRate);
+
+        if (note.isRest)
+        {
+            position += length; // Already zero
+            continue;
+        }
+
+        // Square wave from a fixed-point phase accumulator, restarted for each note
+        const uint32_t increment = staticSongPhaseIncrement(note, sampleRate);
+        uint32_t phase = 0;
+        for (size_t s = 0; s < length; ++s, ++position)
+        {
+            samples[position] = int16_t((phase & 0x80000000u) ? -amplitude : amplitude);
+            phase += increment;
+        }
+    }
+
+    return samples;
+}
+
+
+/**
+ * @class StaticSong
+ * @brief Renders a constexpr array of SongNotes to square wave PCM at compile time.
+ *
+ * The rendered samples are a `static constexpr` array, so they live in read-only memory and
+ * are ready to play with zero startup work and no synthesis at runtime. Invalid notes and
+ * songs that are too long are rejected with a static_assert.
+ *
+ * @code
+ * static constexpr SongNote JINGLE[] = {{NoteName::C, 5, 100}, SongNote::rest(50), {NoteName::G, 5, 200}};
+ * using Jingle = StaticSong<JINGLE>;
+ * driver.playSamples(Jingle::pcm.data(), Jingle::SAMPLE_COUNT);
+ * @endcode
+ *
+ * @tparam Notes      A constexpr array of SongNote with static storage duration.
+ * @tparam SampleRate Output sample rate in Hz (must match the driver it is played on).
+ * @tparam Amplitude  Peak output level (0 to 32767).
+ */
+template <const auto& Notes, int SampleRate = 44100, int Amplitude = 16384>
+class StaticSong
+{
+    static_assert(SampleRate > 0, "StaticSong sample rate must be positive");
+    static_assert(Amplitude >= 0 && Amplitude <= 32767, "StaticSong amplitude must be between 0 and 32767");
+    static_assert(isValidStaticSong(Notes), "StaticSong contains an invalid note, octave (0-6) or duration (must be > 0)");
+
+public:
+    static constexpr int SAMPLE_RATE = SampleRate;                                  ///< Output sample rate in Hz.
+    static constexpr size_t NOTE_COUNT = std::size(Notes);                          ///< Number of notes and rests in the song.
+    static constexpr size_t SAMPLE_COUNT = countStaticSongSamples(Notes, SampleRate); ///< Number of rendered samples.
+
+    static_assert(SAMPLE_COUNT > 0, "StaticSong is empty");
+    static_assert(SAMPLE_COUNT <= STATIC_SONG_MAX_SAMPLES, "StaticSong is too long to render at compile time");
+
+    /// @brief The rendered song, in read-only memory.
+    static constexpr std::array<int16_t, SAMPLE_COUNT> pcm = renderStaticSong<SAMPLE_COUNT>(Notes, SampleRate, Amplitude);
+};
+
+#endif // STATIC_SONG_H
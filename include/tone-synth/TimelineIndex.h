@@ -0,0 +1,130 @@
+/// @file TimelineIndex.h
+/// @brief Definition of the TimelineIndex class which seeks to any sample of a long song without replaying what came before.
+
+#ifndef TIMELINE_INDEX_H
+#define TIMELINE_INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include "tone-synth/StaticSong.h"
+#include "tone-synth/SegmentedRenderer.h"
+
+/**
+ * @struct TimelinePosition
+ * @brief Playback state at a sample of a song: the note sounding there and the oscillator phase.
+ *
+ * Returned by TimelineIndex::seek() and advanced by TimelineIndex::render().
+ */
+struct TimelinePosition
+{
+    size_t sample = 0;      ///< Sample index in the song.
+    size_t event = 0;       ///< Index of the note sounding at that sample.
+    uint32_t phase = 0;     ///< Oscillator phase at that sample, as a 32-bit fraction of a cycle.
+};
+
+/**
+ * @class TimelineIndex
+ * @brief An index of a song's notes by start sample, with periodic phase checkpoints, for fast seeking.
+ *
+ * seek() binary-searches the note start times for the note sounding at a sample (O(log n)),
+ * then takes the oscillator phase from the nearest checkpoint at or before that note and adds
+ * the increments of the few notes in between (at most getCheckpointInterval() - 1). Nothing
+ * before the checkpoint is rendered or replayed, so seeking into the last minute of an
+ * hour-long song costs the same as seeking into the first.
+ *
+ * render() carries on from a position exactly as a render from the start would, so playback
+ * can begin mid-note on the right phase and continue chunk by chunk:
+ *
+ * @code
+ * TimelineIndex index(song);
+ * TimelinePosition position = index.seekMs(95000);
+ * int16_t chunk[2048];
+ * size_t count = index.render(position, chunk, 2048, 16384); // then queue it, e.g. with ToneDriverSDL2::queueSamples()
+ * @endcode
+ *
+ * The oscillator is the same 32-bit phase accumulator as SegmentedRenderer's, so a render from
+ * any position matches SegmentedRenderer::renderRange() sample for sample. Rests hold the phase.
+ */
+class TimelineIndex
+{
+public:
+    /**
+     * @brief Constructor. Indexes the song and records a phase checkpoint every checkpointInterval notes.
+     *
+     * @param notes              The song. Notes outside the valid range are indexed as rests.
+     * @param mode               Whether the phase carries on between notes.
+     * @param sampleRate         Sample rate in Hz.
+     * @param checkpointInterval Notes between phase checkpoints (bounds the work per seek).
+     */
+    TimelineIndex(const std::vector<SongNote>& notes, PhaseMode mode = PhaseMode::Continuous,
+                  int sampleRate = DEFAULT_SAMPLE_RATE, size_t checkpointInterval = DEFAULT_CHECKPOINT_INTERVAL);
+
+    /**
+     * @brief Finds the playback state at a sample.
+     *
+     * @param sample Sample index (clamped to the end of the song).
+     * @return The position, ready to render().
+     */
+    TimelinePosition seek(size_t sample) const;
+
+    /**
+     * @brief Finds the playback state at a time.
+     *
+     * @param timeMs Time from the start of the song in milliseconds.
+     * @return The position, ready to render().
+     */
+    TimelinePosition seekMs(long timeMs) const;
+
+    /**
+     * @brief Renders samples from a position and moves the position past them.
+     *
+     * @param position  Where to start. Updated to the sample after the last one rendered.
+     * @param out       Receives up to count samples.
+     * @param count     Number of samples wanted.
+     * @param amplitude Peak output level (0 to 32767).
+     * @return Number of samples rendered (less than count at the end of the song).
+     */
+    size_t render(TimelinePosition& position, int16_t* out, size_t count, int amplitude) const;
+
+    /** @brief Gets the length of the song in samples. */
+    size_t getSampleCount() const;
+
+    /** @brief Gets the number of notes and rests indexed. */
+    size_t getEventCount() const;
+
+    /** @brief Gets the number of notes between phase checkpoints. */
+    size_t getCheckpointInterval() const;
+
+    /** @brief Gets the memory used by the index in bytes. */
+    size_t getMemoryBytes() const;
+
+    static constexpr int DEFAULT_SAMPLE_RATE = 44100;           ///< Default sample rate in Hz.
+    static constexpr size_t DEFAULT_CHECKPOINT_INTERVAL = 64;   ///< Default notes between phase checkpoints.
+
+private:
+    /**
+     * @brief Finds the note sounding at a sample.
+     *
+     * @param sample Sample index (less than getSampleCount()).
+     * @return Index of the note.
+     */
+    size_t findEvent(size_t sample) const;
+
+    /**
+     * @brief Gets the phase at the first sample of a note from the checkpoint at or before it.
+     *
+     * @param event Index of the note.
+     * @return The phase.
+     */
+    uint32_t getStartPhase(size_t event) const;
+
+    PhaseMode mode_;                        ///< Whether the phase carries on between notes.
+    int sampleRate_;                        ///< Sample rate in Hz.
+    size_t checkpointInterval_;             ///< Notes between checkpoints.
+    std::vector<size_t> offsets_;           ///< First sample of each note, plus the total length at the end.
+    std::vector<uint32_t> increments_;      ///< Phase increment of each note (0 for rests).
+    std::vector<uint32_t> checkpoints_;     ///< Phase at the first sample of every checkpointInterval_-th note.
+};
+
+#endif // TIMELINE_INDEX_H
@@ -0,0 +1,33 @@
+/// @file ToneAutomation.h
+/// @brief Definition of the ToneAutomation struct which describes pitch and amplitude changes over a note.
+
+#ifndef TONE_AUTOMATION_H
+#define TONE_AUTOMATION_H
+
+/**
+ * @enum GlideCurve
+ * @brief Shape of a pitch glide.
+ */
+enum class GlideCurve {
+    Linear,     ///< Frequency changes by the same number of Hertz every second.
+    Exponential ///< Frequency changes by the same number of semitones every second (sounds even).
+};
+
+/**
+ * @struct ToneAutomation
+ * @brief Frequency and amplitude automation for one note, described once and evaluated by a Voice.
+ *
+ * The default value describes no automation at all.
+ */
+struct ToneAutomation
+{
+    float glideToFrequency = 0.0f;                  ///< Frequency to reach by the end of the note, in Hertz (0 for no glide).
+    GlideCurve glideCurve = GlideCurve::Exponential; ///< Shape of the glide.
+    float vibratoRateHz = 0.0f;                     ///< Vibrato speed in Hertz (0 for no vibrato).
+    float vibratoDepthSemitones = 0.0f;             ///< Vibrato depth either side of the pitch, in semitones.
+    float pitchBendSemitones = 0.0f;                ///< Constant pitch offset in semitones (may be negative).
+    float startAmplitude = 1.0f;                    ///< Amplitude at the start of the note (0.0 to 1.0, scales the driver amplitude).
+    float endAmplitude = 1.0f;                      ///< Amplitude at the end of the note, reached by a linear ramp.
+};
+
+#endif // TONE_AUTOMATION_H
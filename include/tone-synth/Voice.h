@@ -0,0 +1,119 @@
+/// @file Voice.h
+/// @brief Definition of the Voice class which generates one oscillator with per-note automation.
+
+#ifndef VOICE_H
+#define VOICE_H
+
+#include <stdint.h>
+#include "tone-synth/ToneAutomation.h"
+#include "tone-synth/Wavetable.h"
+
+/**
+ * @class Voice
+ * @brief A single oscillator with pitch and amplitude automation.
+ *
+ * The oscillator is a 64-bit fixed-point phase accumulator (2^64 = one cycle), so the frequency
+ * can change on any sample without a discontinuity, and the phase wraps exactly: after any
+ * number of samples it is the sum of the increments modulo 2^64, with no rounding error building
+ * up over days of playback. The only frequency error is the increment's resolution of
+ * sampleRate / 2^64 Hz. Automation (glides, vibrato, pitch bend) is evaluated once every
+ * CONTROL_BLOCK samples; amplitude ramps are evaluated every sample.
+ *
+ * The default waveform is the 1-bit square (Waveform::Buzzer). The band-limited waveforms read
+ * the shared WavetableBank, switching to a table with fewer harmonics whenever the pitch
+ * crosses an octave boundary, so they stay alias-free up to the top of the range. Voices only
+ * point into those read-only tables and never allocate, so they can live in fixed arrays
+ * inside an audio callback (build the tables with WavetableBank::get() before audio starts).
+ */
+class Voice
+{
+public:
+    /**
+     * @brief Start a note with no automation that plays until stopped.
+     * 
+     * @param frequency  Frequency in Hertz.
+     * @param sampleRate Output sample rate in Hz.
+     */
+    void start(float frequency, int sampleRate);
+
+    /**
+     * @brief Start a note of known length with automation.
+     * 
+     * @param frequency  Starting frequency in Hertz.
+     * @param samples    Length of the note in samples (the automation spans this length).
+     * @param automation Pitch and amplitude automation.
+     * @param sampleRate Output sample rate in Hz.
+     */
+    void start(float frequency, uint32_t samples, const ToneAutomation& automation, int sampleRate);
+
+    /**
+     * @brief Change the frequency without restarting the phase.
+     * 
+     * @param frequency Frequency in Hertz.
+     */
+    void setFrequency(float frequency);
+
+    /**
+     * @brief Change the waveform. Kept across start() calls.
+     * 
+     * @param waveform   The waveform.
+     * @param pulseWidth Fraction of the cycle spent high, for Waveform::Pulse (0.5 is a square).
+     */
+    void setWaveform(Waveform waveform, float pulseWidth = DEFAULT_PULSE_WIDTH);
+
+    /** @brief Gets the waveform. */
+    Waveform getWaveform() const;
+
+    /** @brief Silence the voice. */
+    void stop();
+
+    /**
+     * @brief Generate the next sample.
+     * 
+     * @return Sample from -1.0 to 1.0, or 0.0 if the voice is stopped.
+     */
+    float nextSample();
+
+    /** @brief Checks whether the voice is sounding. */
+    bool isActive() const;
+
+    /** @brief Gets the frequency currently being generated (including automation), in Hertz. */
+    float getCurrentFrequency() const;
+
+    /** @brief Gets the oscillator phase (2^64 = one cycle). */
+    uint64_t getPhase() const;
+
+    /** @brief Gets the number of samples generated since the note started. */
+    uint64_t getElapsedSamples() const;
+
+    static constexpr int CONTROL_BLOCK = 16;    ///< Samples between automation updates.
+    static constexpr float DEFAULT_PULSE_WIDTH = 0.25f; ///< Default duty cycle of Waveform::Pulse.
+    static constexpr float MIN_PULSE_WIDTH = 0.01f;     ///< Narrowest duty cycle of Waveform::Pulse (and 1 - this the widest).
+
+private:
+    /** @brief Recomputes the phase increment from the automation at the current position. */
+    void updateControl();
+
+    /** @brief Picks the table with the most harmonics that stay below Nyquist at the current increment. */
+    void selectTable();
+
+    bool active_ = false;           ///< True while the voice is sounding.
+    bool automated_ = false;        ///< True if automation is applied.
+    uint64_t phase_ = 0;            ///< Fixed-point phase (2^64 = one cycle).
+    uint64_t increment_ = 0;        ///< Phase increment per sample.
+    uint64_t vibratoIncrement_ = 0; ///< Vibrato phase increment per sample (2^64 = one cycle).
+    float frequency_ = 0.0f;        ///< Base (starting) frequency in Hertz.
+    float currentFrequency_ = 0.0f; ///< Frequency after automation in Hertz.
+    int sampleRate_ = 44100;        ///< Output sample rate in Hz.
+    uint64_t elapsed_ = 0;          ///< Samples generated since the note started.
+    uint32_t length_ = 0;           ///< Length of the note in samples (0 if unknown).
+    int controlCountdown_ = 0;      ///< Samples until the next automation update.
+    ToneAutomation automation_;     ///< Automation applied to the note.
+    Waveform waveform_ = Waveform::Buzzer; ///< Shape of the wave.
+    const float* table_ = nullptr;  ///< Band-limited table for the current pitch (shared, read-only).
+    uint64_t pulseWidth_ = 0;       ///< Pulse duty cycle as a phase (2^64 = one cycle).
+    uint64_t pulseOffset_ = 0;      ///< Phase shift that starts the pulse high at the start of the cycle.
+    float pulseDc_ = 0.0f;          ///< Mean level of the pulse, added back to the difference of the sawtooths.
+};
+
+#endif // VOICE_H
@@ -0,0 +1,104 @@
+/// @file Wavetable.h
+/// @brief Definition of the WavetableBank class which holds band-limited, mipmapped waveform tables shared by every Voice.
+
+#ifndef WAVETABLE_H
+#define WAVETABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+/**
+ * @enum Waveform
+ * @brief Shape of the wave a Voice plays.
+ */
+enum class Waveform {
+    Buzzer,     ///< The original 1-bit square, as a piezo buzzer plays it. Exact, but aliases on high notes.
+    Square,     ///< Band-limited square.
+    Pulse,      ///< Band-limited pulse with a variable duty cycle.
+    Triangle,   ///< Band-limited triangle.
+    Saw         ///< Band-limited rising sawtooth.
+};
+
+/**
+ * @class WavetableBank
+ * @brief Precomputed band-limited single-cycle tables, one per octave, for each Waveform.
+ *
+ * Each waveform has MIP_LEVELS tables of TABLE_SIZE samples. Level k holds the harmonics
+ * below the Nyquist frequency for a fundamental of up to 2^k / TABLE_SIZE cycles per sample,
+ * so choosing the level from the phase increment keeps every harmonic below Nyquist at any
+ * sample rate. The tables are summed from the Fourier series once, on the first call to get(),
+ * and are read-only after that, so every voice on every thread shares them. Playing a
+ * table costs one lookup and a linear interpolation per sample (two for Waveform::Pulse,
+ * which is the difference of two sawtooths offset by the duty cycle).
+ *
+ * The tables keep the overshoot of the band-limited series (about 9% at the edges of the
+ * square and sawtooth) rather than being scaled down, so every waveform has the same
+ * fundamental level as the 1-bit square.
+ */
+class WavetableBank
+{
+public:
+    /**
+     * @brief Gets the shared tables, building them on the first call.
+     *
+     * Call once before audio starts: the first call allocates and takes a few milliseconds.
+     *
+     * @return The bank.
+     */
+    static const WavetableBank& get();
+
+    /**
+     * @brief Gets the table to play a waveform at a pitch.
+     *
+     * @param waveform  The waveform (Waveform::Pulse uses the sawtooth tables; Waveform::Buzzer has none).
+     * @param increment Phase increment per sample (2^64 = one cycle).
+     * @return TABLE_SIZE + 1 samples (the last repeats the first), or nullptr for Waveform::Buzzer.
+     */
+    const float* getTable(Waveform waveform, uint64_t increment) const;
+
+    /**
+     * @brief Gets the mip level for a phase increment: the most harmonics that stay below Nyquist.
+     *
+     * @param increment Phase increment per sample (2^64 = one cycle).
+     * @return Level from 0 (every harmonic) to MIP_LEVELS - 1 (the fundamental only).
+     */
+    static int getMipLevel(uint64_t increment);
+
+    /**
+     * @brief Reads a table at a phase, interpolating between neighbouring samples.
+     *
+     * @param table A table from getTable().
+     * @param phase Phase (2^64 = one cycle).
+     * @return The sample.
+     */
+    static inline float lookup(const float* table, uint64_t phase)
+    {
+        const uint32_t index = uint32_t(phase >> (64 - TABLE_BITS));
+        const float fraction = float(uint32_t(phase >> (64 - TABLE_BITS - 24)) & 0xFFFFFFu) * (1.0f / 16777216.0f);
+        return table[index] + ((table[index + 1] - table[index]) * fraction);
+    }
+
+    /** @brief Gets the memory used by the tables in bytes. */
+    size_t getMemoryBytes() const;
+
+    static constexpr int TABLE_BITS = 11;                   ///< log2 of TABLE_SIZE.
+    static constexpr int TABLE_SIZE = 1 << TABLE_BITS;      ///< Samples per cycle.
+    static constexpr int MIP_LEVELS = TABLE_BITS;           ///< Tables per waveform: TABLE_SIZE / 2 harmonics down to 1.
+
+private:
+    /** @brief Builds every table. */
+    WavetableBank();
+
+    /**
+     * @brief Gets a table by index.
+     *
+     * @param shape Index of the shape (square, triangle, saw).
+     * @param level Mip level.
+     */
+    const float* table(int shape, int level) const;
+
+    std::vector<float> tables_;     ///< Every table, by shape then level, TABLE_SIZE + 1 samples each.
+};
+
+#endif // WAVETABLE_H
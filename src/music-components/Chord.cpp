@@ -0,0 +1,142 @@
+/// @file Chord.cpp
+/// @brief Implementation of the Chord class.
+
+#include "music-components/Chord.h"
+#include <cstdio>     // for snprintf
+
+
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+Chord::Chord() : Chord(Note(), ChordQuality::Major) {}
+Chord::Chord(const Note& root, ChordQuality quality) : root_(root), quality_(quality)
+{
+    if (quality_ < ChordQuality::Major || quality_ > ChordQuality::Dominant9)
+    {
+        quality_ = ChordQuality::Major;
+    }
+}
+
+
+// ----------------------------------------- H E L P E R S -----------------------------------------
+ChordVoicing Chord::getVoicing(int inversion, ChordVoicingStyle style) const
+{
+    const Shape& shape = SHAPES[int(quality_)];
+    const int count = shape.count;
+    const int lowestPitch = 0;
+    const int highestPitch = ((Note::MAX_OCTAVE + 1) * Note::NOTES_PER_OCTAVE) - 1;
+
+    // Absolute pitches (semitones above C0) in root position
+    int pitches[MAX_NOTES] = {};
+    int rootPitch = (root_.getOctave() * Note::NOTES_PER_OCTAVE) + int(root_.getNoteName());
+    for (int i = 0; i < count; ++i)
+    {
+        pitches[i] = rootPitch + shape.intervals[i];
+    }
+
+    // Each inversion moves the lowest note to the top, an octave up
+    inversion = (inversion > 0 && count > 0) ? (inversion % count) : 0;
+    for (int i = 0; i < inversion; ++i)
+    {
+        int lowest = pitches[0] + Note::NOTES_PER_OCTAVE;
+        for (int j = 1; j < count; ++j)
+        {
+            pitches[j - 1] = pitches[j];
+        }
+        pitches[count - 1] = lowest;
+    }
+
+    if (style == ChordVoicingStyle::Drop2 && count >= 3)
+    {
+        pitches[count - 2] -= Note::NOTES_PER_OCTAVE;
+    }
+    else if (style == ChordVoicingStyle::Spread && count > 0)
+    {
+        pitches[0] -= Note::NOTES_PER_OCTAVE;
+    }
+
+    // Keep the voicing ordered lowest first (at most 5 notes, so insertion sort)
+    for (int i = 1; i < count; ++i)
+    {
+        int pitch = pitches[i];
+        int j = i - 1;
+        while (j >= 0 && pitches[j] > pitch)
+        {
+            pitches[j + 1] = pitches[j];
+            --j;
+        }
+        pitches[j + 1] = pitch;
+    }
+
+    // Shift by whole octaves to stay within the playable range
+    int shift = 0;
+    while (count > 0 && pitches[count - 1] + shift > highestPitch)
+    {
+        shift -= Note::NOTES_PER_OCTAVE;
+    }
+    while (count > 0 && pitches[0] + shift < lowestPitch)
+    {
+        shift += Note::NOTES_PER_OCTAVE;
+    }
+
+    ChordVoicing voicing;
+    voicing.count = count;
+    for (int i = 0; i < count; ++i)
+    {
+        int pitch = pitches[i] + shift;
+        voicing.notes[i] = NoteName(pitch % Note::NOTES_PER_OCTAVE);
+        voicing.octaves[i] = pitch / Note::NOTES_PER_OCTAVE;
+    }
+
+    return voicing;
+}
+
+// NOTE: Uses static buffer; not safe for multiple simultaneous calls (fine if output is immediately printed)
+const char* Chord::toString() const
+{
+    static char chordStr[16];
+    snprintf(chordStr, sizeof(chordStr), "%s%s", root_.getNoteNameString(), SHAPES[int(quality_)].suffix);
+
+    return chordStr;
+}
+
+
+// ----------------------------------------- S E T T E R S -----------------------------------------
+void Chord::setRoot(const Note& newRoot)
+{
+    root_ = newRoot;
+}
+
+void Chord::setQuality(const ChordQuality newQuality)
+{
+    if (newQuality >= ChordQuality::Major && newQuality <= ChordQuality::Dominant9)
+    {
+        quality_ = newQuality;
+    }
+}
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+const Note& Chord::getRoot() const
+{
+    return root_;
+}
+
+ChordQuality Chord::getQuality() const
+{
+    return quality_;
+}
+
+int Chord::getNoteCount() const
+{
+    return SHAPES[int(quality_)].count;
+}
+
+int Chord::getInterval(int index) const
+{
+    const Shape& shape = SHAPES[int(quality_)];
+    if (index < 0 || index >= shape.count)
+    {
+        return 0;
+    }
+
+    return shape.intervals[index];
+}
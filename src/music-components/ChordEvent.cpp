@@ -0,0 +1,48 @@
+/// @file ChordEvent.cpp
+/// @brief Implementation of the ChordEvent class.
+
+#include "music-components/ChordEvent.h"
+
+
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+ChordEvent::ChordEvent() : ChordEvent(Chord(), DEFAULT_DURATION_MS) {}
+ChordEvent::ChordEvent(const Chord& chord, int durationMs, int inversion, ChordVoicingStyle style)
+    : chord_(chord), durationMs_(durationMs), inversion_(inversion), style_(style)
+{
+    if (durationMs_ < 0)
+    {
+        durationMs_ = DEFAULT_DURATION_MS;
+    }
+}
+
+
+// ----------------------------------------- S E T T E R S -----------------------------------------
+void ChordEvent::setChord(const Chord& newChord)
+{
+    chord_ = newChord;
+}
+
+void ChordEvent::setDurationMs(int newDurationMs)
+{
+    if (newDurationMs >= 0)
+    {
+        durationMs_ = newDurationMs;
+    }
+}
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+const Chord& ChordEvent::getChord() const
+{
+    return chord_;
+}
+
+int ChordEvent::getDurationMs() const
+{
+    return durationMs_;
+}
+
+ChordVoicing ChordEvent::getVoicing() const
+{
+    return chord_.getVoicing(inversion_, style_);
+}
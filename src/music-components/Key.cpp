@@ -0,0 +1,70 @@
+/// @file Key.cpp
+/// @brief Implementation of the Key class.
+
+#include "music-components/Key.h"
+
+
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+Key::Key() : Key(DEFAULT_ROOT, DEFAULT_SCALE) {}
+Key::Key(NoteName root, ScaleType type) : Key(root, Scale(type)) {}
+Key::Key(NoteName root, const Scale& scale) : root_(root), scale_(scale)
+{
+    if (!Note::isValidNote(root_, 0))
+    {
+        root_ = DEFAULT_ROOT;
+    }
+
+    pitchClassMask_ = Scale::rotate(scale_.getMask(), int(root_));
+}
+
+
+// ----------------------------------------- H E L P E R S -----------------------------------------
+bool Key::contains(NoteName note) const
+{
+    return (pitchClassMask_ >> int(note)) & 1u;
+}
+
+bool Key::contains(const Note& note) const
+{
+    return contains(note.getNoteName());
+}
+
+Note Key::getNote(int degree, uint8_t octave) const
+{
+    if (degree < 0)
+    {
+        return Note();
+    }
+
+    return Note(root_, octave) + scale_.getInterval(degree);
+}
+
+void Key::transpose(int semitones)
+{
+    int root = ((int(root_) + semitones) % Note::NOTES_PER_OCTAVE + Note::NOTES_PER_OCTAVE) % Note::NOTES_PER_OCTAVE;
+
+    root_ = NoteName(root);
+    pitchClassMask_ = Scale::rotate(pitchClassMask_, semitones);
+}
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+NoteName Key::getRoot() const
+{
+    return root_;
+}
+
+const Scale& Key::getScale() const
+{
+    return scale_;
+}
+
+uint16_t Key::getPitchClassMask() const
+{
+    return pitchClassMask_;
+}
+
+int Key::getDegreeCount() const
+{
+    return scale_.getDegreeCount();
+}
@@ -0,0 +1,183 @@
+/// @file TrackerSong.cpp
+/// @brief Implementation of the TrackerSong and TrackerCursor classes.
+
+#include "music-components/TrackerSong.h"
+
+
+/// @brief Number of times an order plays its pattern (a repeat of 0 still plays once).
+static int getPasses(const TrackerOrder& order)
+{
+    return (order.repeat > 0) ? order.repeat : 1;
+}
+
+
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+TrackerSong::TrackerSong(const TrackerStep* steps, int stepCount, const TrackerPattern* patterns, int patternCount,
+                         const TrackerOrder* orders, int orderCount, int rowMs)
+    : steps_(steps), stepCount_(stepCount), patterns_(patterns), patternCount_(patternCount),
+      orders_(orders), orderCount_(orderCount), rowMs_(rowMs)
+{
+    if (rowMs_ <= 0)
+    {
+        rowMs_ = DEFAULT_ROW_MS;
+    }
+}
+
+
+// ----------------------------------------- H E L P E R S -----------------------------------------
+bool TrackerSong::isValid() const
+{
+    for (int i = 0; i < patternCount_; ++i)
+    {
+        if (patterns_[i].firstStep + patterns_[i].stepCount > stepCount_) return false;
+    }
+
+    for (int i = 0; i < orderCount_; ++i)
+    {
+        if (orders_[i].pattern >= patternCount_) return false;
+    }
+
+    return true;
+}
+
+TrackerMemoryReport TrackerSong::getMemoryReport() const
+{
+    TrackerMemoryReport report;
+    report.patternBytes = (stepCount_ * sizeof(TrackerStep)) + (patternCount_ * sizeof(TrackerPattern)) + (orderCount_ * sizeof(TrackerOrder));
+    report.flatEvents = getEventCount();
+    report.flatBytes = report.flatEvents * sizeof(TrackerStep);
+    report.compressionRatio = (report.patternBytes > 0) ? float(report.flatBytes) / float(report.patternBytes) : 0.0f;
+
+    return report;
+}
+
+size_t TrackerSong::getEventCount() const
+{
+    size_t count = 0;
+
+    for (int i = 0; i < orderCount_; ++i)
+    {
+        if (orders_[i].pattern < patternCount_)
+        {
+            count += size_t(patterns_[orders_[i].pattern].stepCount) * getPasses(orders_[i]);
+        }
+    }
+
+    return count;
+}
+
+long TrackerSong::getDurationMs() const
+{
+    long rows = 0;
+
+    for (int i = 0; i < orderCount_; ++i)
+    {
+        if (orders_[i].pattern >= patternCount_) continue;
+
+        const TrackerPattern& pattern = patterns_[orders_[i].pattern];
+        long patternRows = 0;
+        for (int step = 0; step < pattern.stepCount && pattern.firstStep + step < stepCount_; ++step)
+        {
+            patternRows += steps_[pattern.firstStep + step].rows;
+        }
+        rows += patternRows * getPasses(orders_[i]);
+    }
+
+    return rows * rowMs_;
+}
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+const TrackerStep& TrackerSong::getStep(int index) const
+{
+    return steps_[index];
+}
+
+int TrackerSong::getStepCount() const
+{
+    return stepCount_;
+}
+
+const TrackerPattern& TrackerSong::getPattern(int index) const
+{
+    return patterns_[index];
+}
+
+const TrackerOrder& TrackerSong::getOrder(int index) const
+{
+    return orders_[index];
+}
+
+int TrackerSong::getPatternCount() const
+{
+    return patternCount_;
+}
+
+int TrackerSong::getOrderCount() const
+{
+    return orderCount_;
+}
+
+int TrackerSong::getRowMs() const
+{
+    return rowMs_;
+}
+
+
+// ------------------------------------ C O N S T R U C T O R S ------------------------------------
+TrackerCursor::TrackerCursor(const TrackerSong& song) : song_(song) {}
+
+
+// ----------------------------------------- H E L P E R S -----------------------------------------
+bool TrackerCursor::next(TrackerEvent& event)
+{
+    while (order_ < song_.getOrderCount())
+    {
+        const TrackerOrder& order = song_.getOrder(order_);
+        if (order.pattern >= song_.getPatternCount())
+        {
+            ++order_; // Skip orders that refer to a missing pattern
+            continue;
+        }
+
+        const TrackerPattern& pattern = song_.getPattern(order.pattern);
+
+        if (step_ >= pattern.stepCount || pattern.firstStep + step_ >= song_.getStepCount())
+        {
+            // End of the pattern, or of the step table: play it again or move to the next order
+            step_ = 0;
+            if (++pass_ >= getPasses(order))
+            {
+                pass_ = 0;
+                ++order_;
+            }
+            continue;
+        }
+
+        const TrackerStep& step = song_.getStep(pattern.firstStep + step_);
+        ++step_;
+
+        int pitch = int(step.pitch) + order.transpose;
+        event.durationMs = step.rows * song_.getRowMs();
+        event.isRest = (step.pitch == TRACKER_REST) || pitch < 0 || !Note::isValidNote(NoteName(pitch % 12), pitch / 12);
+        event.note = event.isRest ? Note() : Note(NoteName(pitch % 12), uint8_t(pitch / 12));
+
+        return true;
+    }
+
+    return false;
+}
+
+void TrackerCursor::reset()
+{
+    order_ = 0;
+    pass_ = 0;
+    step_ = 0;
+}
+
+
+// ----------------------------------------- G E T T E R S -----------------------------------------
+int TrackerCursor::getOrderIndex() const
+{
+    return order_;
+}
@@ -6,4 +6,82 @@
 void playNote(ToneDriver &driver, Note &note, int durationMs)
 {
     driver.playNote(note.getNoteName(), note.getOctave(), durationMs);
-}
\ No newline at end of file
+}
+
+void playChord(ToneDriver &driver, Chord &chord, int durationMs)
+{
+    ChordVoicing voicing = chord.getVoicing();
+    driver.playChord(voicing.notes, voicing.octaves, voicing.count, durationMs);
+}
+
+void playChordEvent(ToneDriver &driver, ChordEvent &chordEvent)
+{
+    ChordVoicing voicing = chordEvent.getVoicing();
+    driver.playChord(voicing.notes, voicing.octaves, voicing.count, chordEvent.getDurationMs());
+}
+
+void playScale(ToneDriver &driver, Key &key, uint8_t startOctave, int octaves, int noteDurationMs, int restMs)
+{
+    NoteName notes[MAX_SCALE_NOTES];
+    int noteOctaves[MAX_SCALE_NOTES];
+
+    int count = getScaleRun(key, startOctave, octaves, notes, noteOctaves);
+    if (count > 0)
+    {
+        driver.playSequence(notes, noteOctaves, count, noteDurationMs, restMs);
+    }
+}
+
+void playTrackerSong(ToneDriver &driver, const TrackerSong &song)
+{
+    if (!song.isValid())
+    {
+        return;
+    }
+
+    TrackerCursor cursor(song);
+    TrackerEvent event;
+
+    while (cursor.next(event))
+    {
+        if (event.isRest)
+        {
+            driver.rest(event.durationMs);
+        }
+        else
+        {
+            driver.playNote(event.note.getNoteName(), event.note.getOctave(), event.durationMs);
+        }
+    }
+}
+
+int getScaleRun(Key &key, uint8_t startOctave, int octaves, NoteName notes[MAX_SCALE_NOTES], int noteOctaves[MAX_SCALE_NOTES])
+{
+    int count = 0;
+
+    int degrees = key.getDegreeCount() * octaves;
+    if (degrees < 1 || (2 * degrees) + 1 > MAX_SCALE_NOTES)
+    {
+        return 0;
+    }
+
+    // Key::getNote() resets notes out of range to C4, so the top note must be checked first
+    int top = (startOctave * Note::NOTES_PER_OCTAVE) + int(key.getRoot()) + key.getScale().getInterval(degrees);
+    if (!Note::isValidNote(NoteName(top % Note::NOTES_PER_OCTAVE), top / Note::NOTES_PER_OCTAVE))
+    {
+        return 0;
+    }
+
+    // Ascend to the top note, then descend back to the root without repeating the top note
+    for (int step = 0; step <= 2 * degrees; ++step)
+    {
+        int degree = (step <= degrees) ? step : (2 * degrees) - step;
+        Note note = key.getNote(degree, startOctave);
+
+        notes[count] = note.getNoteName();
+        noteOctaves[count] = note.getOctave();
+        ++count;
+    }
+
+    return count;
+}
@@ -0,0 +1,406 @@
+/// @file ToneDriverPCM.cpp
+/// @brief Raw PCM streaming implementation of the ToneDriver interface.
+
+#include "tone-driver-pcm/ToneDriverPCM.h"
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+const int ToneDriverPCM::REF_FREQ = 440;
+const NoteName ToneDriverPCM::REF_NOTE = NoteName::A;
+const int ToneDriverPCM::REF_OCTAVE = 4;
+
+static const PcmStreamConfig DEFAULT_CONFIG;
+
+
+/**
+ * @brief Gets the size of one sample in bytes.
+ */
+static size_t bytesPerSample(PcmSampleFormat format)
+{
+    return (format == PcmSampleFormat::S16) ? 2 : 4;
+}
+
+
+ToneDriverPCM::ToneDriverPCM(int fd, const PcmStreamConfig& config) : fd(fd), config(config)
+{
+    // Fall back to the defaults for anything out of range
+    if (this->config.sampleRate <= 0) this->config.sampleRate = DEFAULT_CONFIG.sampleRate;
+    if (this->config.channels <= 0) this->config.channels = DEFAULT_CONFIG.channels;
+    if (this->config.blockFrames <= 0) this->config.blockFrames = DEFAULT_CONFIG.blockFrames;
+
+    bytesPerFrame = bytesPerSample(this->config.format) * this->config.channels;
+    blocks[0].resize(bytesPerFrame * this->config.blockFrames);
+    blocks[1].resize(bytesPerFrame * this->config.blockFrames);
+
+    streamStart = std::chrono::steady_clock::now();
+    writerThread = std::thread(&ToneDriverPCM::writerLoop, this);
+}
+
+void ToneDriverPCM::playFrequency(float freq)
+{
+    catchUp();
+    startTone(freq);
+    pace();
+}
+
+void ToneDriverPCM::playFrequency(float freq, int durationMs)
+{
+    renderStep(freq, durationMs);
+    stop();
+    diagnostics.flush(); // Print any logged errors after the blocking call
+}
+
+void ToneDriverPCM::playNote(NoteName note, int octave)
+{
+    if (isValidNote(note, octave))
+    {
+        playFrequency(getNoteFrequency(note, octave));
+    }
+}
+
+void ToneDriverPCM::playNote(NoteName note, int octave, int durationMs)
+{
+    if (isValidNote(note, octave))
+    {
+        playFrequency(getNoteFrequency(note, octave), durationMs);
+    }
+}
+
+void ToneDriverPCM::playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count)
+{
+    playArpeggio(notes, octaves, count, DEFAULT_CHORD_ARPEGGIO_DELAY_MS);
+}
+
+void ToneDriverPCM::playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int durationMs)
+{
+    if (!isValidNoteCount(count))
+    {
+        return;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (!isValidNote(notes[i], octaves[i]))
+        {
+            return;
+        }
+    }
+
+    // Cycle through the chord tones for the whole duration
+    for (int elapsedMs = 0, i = 0; elapsedMs < durationMs; elapsedMs += DEFAULT_CHORD_ARPEGGIO_DELAY_MS, i = (i + 1) % count)
+    {
+        int stepMs = (durationMs - elapsedMs < DEFAULT_CHORD_ARPEGGIO_DELAY_MS) ? durationMs - elapsedMs : DEFAULT_CHORD_ARPEGGIO_DELAY_MS;
+        renderStep(getNoteFrequency(notes[i], octaves[i]), stepMs);
+    }
+
+    stop();
+    diagnostics.flush();
+}
+
+void ToneDriverPCM::playArpeggio(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int noteDurationMs, int delayMs)
+{
+    if (isValidNoteCount(count))
+    {
+        for(int i = 0; i < count; ++i)
+        {
+            playNote(notes[i], octaves[i], noteDurationMs);
+            rest(delayMs);
+        }
+    }
+}
+
+void ToneDriverPCM::playSequence(const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (isValidNote(notes[i], octaves[i]))
+        {
+            renderStep(getNoteFrequency(notes[i], octaves[i]), noteDurationMs);
+            renderStep(0.0f, restMs);
+        }
+    }
+
+    stop();
+    diagnostics.flush();
+}
+
+void ToneDriverPCM::stop()
+{
+    catchUp();
+    startTone(0.0f);
+    pace();
+}
+
+void ToneDriverPCM::stopAfter(int durationMs)
+{
+    advance(durationMs);
+    stop();
+    diagnostics.flush();
+}
+
+void ToneDriverPCM::rest(int durationMs)
+{
+    renderStep(0.0f, durationMs);
+    diagnostics.flush();
+}
+
+void ToneDriverPCM::advance(int durationMs)
+{
+    catchUp();
+    render(msToFrames(durationMs));
+    pace();
+}
+
+void ToneDriverPCM::setAmplitude(float amplitude)
+{
+    this->amplitude = amplitude;
+}
+
+void ToneDriverPCM::flush()
+{
+    if (activeBytes > 0)
+    {
+        submitBlock();
+    }
+
+    std::unique_lock<std::mutex> lock(writerMutex);
+    writerCondition.wait(lock, [this] { return !blockPending; });
+}
+
+bool ToneDriverPCM::isValidNote(NoteName note, int octave)
+{
+    if (note < NoteName::C || note > NoteName::B) {
+        diagnostics.report(DiagnosticCode::InvalidNote, int(note), int(NoteName::B));
+        return false;
+    }
+    if (octave < 0 || octave > MAX_OCTAVE) {
+        diagnostics.report(DiagnosticCode::InvalidOctave, octave, MAX_OCTAVE);
+        return false;
+    }
+
+    return true;
+}
+
+bool ToneDriverPCM::isValidNoteCount(int count)
+{
+    if (count < 1 || count > MAX_POLYPHONY) {
+        diagnostics.report(DiagnosticCode::InvalidNoteCount, count, MAX_POLYPHONY);
+        return false;
+    }
+
+    return true;
+}
+
+ToneDriverDiagnostics& ToneDriverPCM::getDiagnostics()
+{
+    return diagnostics;
+}
+
+uint64_t ToneDriverPCM::getFramesWritten() const
+{
+    return framesWritten.load(std::memory_order_relaxed);
+}
+
+float ToneDriverPCM::getBlockedMs() const
+{
+    return blockedMicros.load(std::memory_order_relaxed) / 1000.0f;
+}
+
+bool ToneDriverPCM::hasWriteError() const
+{
+    return writeError.load(std::memory_order_relaxed);
+}
+
+void ToneDriverPCM::render(uint64_t frames)
+{
+    const size_t blockBytes = blocks[0].size();
+
+    for (uint64_t frame = 0; frame < frames; ++frame)
+    {
+        float sample = toneOn ? amplitude * voice.nextSample() : 0.0f;
+        uint8_t* out = blocks[activeBlock].data() + activeBytes;
+
+        // Encode once, then copy to every channel
+        uint8_t encoded[4];
+        switch (config.format)
+        {
+            case PcmSampleFormat::S16: { int16_t value = int16_t(32767 * sample); std::memcpy(encoded, &value, 2); break; }
+            case PcmSampleFormat::S32: { int32_t value = int32_t(2147483647.0 * sample); std::memcpy(encoded, &value, 4); break; }
+            case PcmSampleFormat::F32: { std::memcpy(encoded, &sample, 4); break; }
+        }
+
+        const size_t sampleBytes = bytesPerFrame / config.channels;
+        for (int channel = 0; channel < config.channels; ++channel)
+        {
+            std::memcpy(out + channel * sampleBytes, encoded, sampleBytes);
+        }
+
+        activeBytes += bytesPerFrame;
+        ++framesRendered;
+
+        if (activeBytes == blockBytes)
+        {
+            submitBlock();
+        }
+    }
+}
+
+void ToneDriverPCM::renderStep(float frequency, int durationMs)
+{
+    catchUp();
+    startTone(frequency);
+    render(msToFrames(durationMs));
+    pace();
+}
+
+void ToneDriverPCM::startTone(float frequency)
+{
+    toneOn = frequency > 0.0f;
+
+    if (toneOn)
+    {
+        voice.start(frequency, config.sampleRate);
+    }
+}
+
+void ToneDriverPCM::catchUp()
+{
+    if (config.pacing != PcmPacing::RealTime)
+    {
+        return;
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - streamStart;
+    uint64_t target = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()) * config.sampleRate / 1000000;
+
+    if (target > framesRendered)
+    {
+        render(target - framesRendered); // Whatever was sounding kept sounding
+    }
+}
+
+void ToneDriverPCM::pace()
+{
+    if (config.pacing != PcmPacing::RealTime)
+    {
+        return;
+    }
+
+    if (activeBytes > 0)
+    {
+        submitBlock(); // Keep a live consumer up to date rather than waiting for a full block
+    }
+
+    std::this_thread::sleep_until(streamStart + std::chrono::microseconds(framesRendered * 1000000 / config.sampleRate));
+}
+
+void ToneDriverPCM::submitBlock()
+{
+    std::unique_lock<std::mutex> lock(writerMutex);
+
+    if (blockPending)
+    {
+        // The consumer is behind: wait for the writer to finish the other block
+        auto waitStart = std::chrono::steady_clock::now();
+        writerCondition.wait(lock, [this] { return !blockPending; });
+        blockedMicros.fetch_add(uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - waitStart).count()), std::memory_order_relaxed);
+    }
+
+    pendingBlock = activeBlock;
+    pendingBytes = activeBytes;
+    blockPending = true;
+    writerCondition.notify_all();
+
+    activeBlock ^= 1;
+    activeBytes = 0;
+}
+
+void ToneDriverPCM::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(writerMutex);
+
+    while (true)
+    {
+        writerCondition.wait(lock, [this] { return blockPending || stopping; });
+
+        if (!blockPending)
+        {
+            break; // Stopping and nothing left to write
+        }
+
+        const uint8_t* data = blocks[pendingBlock].data();
+        size_t bytes = pendingBytes;
+        lock.unlock();
+
+        if (!writeError)
+        {
+            if (writeAll(data, bytes))
+            {
+                framesWritten.fetch_add(bytes / bytesPerFrame, std::memory_order_relaxed);
+            }
+            else
+            {
+                writeError = true; // Discard from now on rather than blocking the renderer
+                diagnostics.report(DiagnosticCode::WriteFailed, errno, 0); // Printed by the next flush()
+            }
+        }
+
+        lock.lock();
+        blockPending = false;
+        writerCondition.notify_all();
+    }
+}
+
+bool ToneDriverPCM::writeAll(const uint8_t* data, size_t bytes)
+{
+    while (bytes > 0)
+    {
+#if defined(_WIN32)
+        int written = _write(fd, data, unsigned(bytes));
+#else
+        ssize_t written = write(fd, data, bytes);
+#endif
+        if (written < 0)
+        {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        data += written;
+        bytes -= size_t(written);
+    }
+
+    return true;
+}
+
+uint64_t ToneDriverPCM::msToFrames(int durationMs) const
+{
+    return (durationMs > 0) ? (uint64_t(durationMs) * config.sampleRate) / 1000 : 0;
+}
+
+float ToneDriverPCM::getNoteFrequency(NoteName note, int octave)
+{
+    int semitonesDiff = (int(note) + (12 * octave)) - (int(REF_NOTE) + (12 * REF_OCTAVE));
+    return REF_FREQ * pow(2, semitonesDiff / 12.0);
+}
+
+ToneDriverPCM::~ToneDriverPCM()
+{
+    flush();
+
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        stopping = true;
+    }
+    writerCondition.notify_all();
+
+    writerThread.join();
+    diagnostics.flush(); // Errors logged since the last blocking call
+}
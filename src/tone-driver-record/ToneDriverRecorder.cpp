@@ -0,0 +1,209 @@
+/// @file ToneDriverRecorder.cpp
+/// @brief Implementation of the ToneDriverRecorder class.
+
+#include "tone-driver-record/ToneDriverRecorder.h"
+#include <cstring>
+
+
+ToneDriverRecorder::ToneDriverRecorder(ToneDriver& target, std::ostream& log, size_t bufferBytes)
+    : target(target), log(log), flushThreshold(bufferBytes)
+{
+    buffer.reserve(bufferBytes + 64); // Headroom for one record past the threshold (larger ones may grow it)
+
+    for (char byte : TONE_DRIVER_LOG_MAGIC)
+    {
+        buffer.push_back(uint8_t(byte));
+    }
+    buffer.push_back(TONE_DRIVER_LOG_VERSION);
+    lastCall = std::chrono::steady_clock::now();
+}
+
+void ToneDriverRecorder::playFrequency(float freq)
+{
+    beginRecord(ToneDriverCall::PlayFrequency);
+    writeFloat(freq);
+    endRecord();
+    target.playFrequency(freq);
+}
+
+void ToneDriverRecorder::playFrequency(float freq, int durationMs)
+{
+    beginRecord(ToneDriverCall::PlayFrequencyFor);
+    writeFloat(freq);
+    writeSigned(durationMs);
+    endRecord();
+    target.playFrequency(freq, durationMs);
+}
+
+void ToneDriverRecorder::playNote(NoteName note, int octave)
+{
+    beginRecord(ToneDriverCall::PlayNote);
+    buffer.push_back(uint8_t(note));
+    writeSigned(octave);
+    endRecord();
+    target.playNote(note, octave);
+}
+
+void ToneDriverRecorder::playNote(NoteName note, int octave, int durationMs)
+{
+    beginRecord(ToneDriverCall::PlayNoteFor);
+    buffer.push_back(uint8_t(note));
+    writeSigned(octave);
+    writeSigned(durationMs);
+    endRecord();
+    target.playNote(note, octave, durationMs);
+}
+
+void ToneDriverRecorder::playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count)
+{
+    beginRecord(ToneDriverCall::PlayChord);
+    writeNotes(notes, octaves, count);
+    endRecord();
+    target.playChord(notes, octaves, count);
+}
+
+void ToneDriverRecorder::playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int durationMs)
+{
+    beginRecord(ToneDriverCall::PlayChordFor);
+    writeNotes(notes, octaves, count);
+    writeSigned(durationMs);
+    endRecord();
+    target.playChord(notes, octaves, count, durationMs);
+}
+
+void ToneDriverRecorder::playArpeggio(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int noteDurationMs, int delayMs)
+{
+    beginRecord(ToneDriverCall::PlayArpeggio);
+    writeNotes(notes, octaves, count);
+    writeSigned(noteDurationMs);
+    writeSigned(delayMs);
+    endRecord();
+    target.playArpeggio(notes, octaves, count, noteDurationMs, delayMs);
+}
+
+void ToneDriverRecorder::playSequence(const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs)
+{
+    beginRecord(ToneDriverCall::PlaySequence);
+    writeNotes(notes, octaves, count);
+    writeSigned(noteDurationMs);
+    writeSigned(restMs);
+    endRecord();
+    target.playSequence(notes, octaves, count, noteDurationMs, restMs);
+}
+
+void ToneDriverRecorder::stop()
+{
+    beginRecord(ToneDriverCall::Stop);
+    endRecord();
+    target.stop();
+}
+
+void ToneDriverRecorder::stopAfter(int durationMs)
+{
+    beginRecord(ToneDriverCall::StopAfter);
+    writeSigned(durationMs);
+    endRecord();
+    target.stopAfter(durationMs);
+}
+
+void ToneDriverRecorder::rest(int durationMs)
+{
+    beginRecord(ToneDriverCall::Rest);
+    writeSigned(durationMs);
+    endRecord();
+    target.rest(durationMs);
+}
+
+bool ToneDriverRecorder::isValidNote(NoteName note, int octave)
+{
+    beginRecord(ToneDriverCall::IsValidNote);
+    buffer.push_back(uint8_t(note));
+    writeSigned(octave);
+    endRecord();
+    return target.isValidNote(note, octave);
+}
+
+void ToneDriverRecorder::flush()
+{
+    if (!buffer.empty())
+    {
+        log.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+        bytesWritten += buffer.size();
+        buffer.clear();
+    }
+
+    log.flush();
+}
+
+uint64_t ToneDriverRecorder::getCallCount() const
+{
+    return callCount;
+}
+
+uint64_t ToneDriverRecorder::getLogBytes() const
+{
+    return bytesWritten + buffer.size();
+}
+
+void ToneDriverRecorder::beginRecord(ToneDriverCall call)
+{
+    auto now = std::chrono::steady_clock::now();
+    uint64_t micros = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(now - lastCall).count());
+    lastCall = now;
+
+    buffer.push_back(uint8_t(call));
+    writeUnsigned(micros);
+    ++callCount;
+}
+
+void ToneDriverRecorder::endRecord()
+{
+    if (buffer.size() >= flushThreshold)
+    {
+        flush();
+    }
+}
+
+void ToneDriverRecorder::writeUnsigned(uint64_t value)
+{
+    // LEB128: seven bits per byte, high bit set on all but the last
+    while (value >= 0x80)
+    {
+        buffer.push_back(uint8_t(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(uint8_t(value));
+}
+
+void ToneDriverRecorder::writeSigned(int64_t value)
+{
+    writeUnsigned((uint64_t(value) << 1) ^ uint64_t(value >> 63)); // Zigzag: small negatives stay small
+}
+
+void ToneDriverRecorder::writeFloat(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        buffer.push_back(uint8_t(bits >> (8 * i)));
+    }
+}
+
+void ToneDriverRecorder::writeNotes(const NoteName notes[], const int octaves[], int count)
+{
+    int recorded = (count < 0) ? 0 : (count > TONE_DRIVER_LOG_MAX_NOTES) ? TONE_DRIVER_LOG_MAX_NOTES : count;
+
+    writeSigned(count); // The call is replayed with the original count, valid or not
+    for (int i = 0; i < recorded; ++i)
+    {
+        buffer.push_back(uint8_t(notes[i]));
+        writeSigned(octaves[i]);
+    }
+}
+
+ToneDriverRecorder::~ToneDriverRecorder()
+{
+    flush();
+}
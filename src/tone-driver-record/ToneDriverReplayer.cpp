@@ -0,0 +1,189 @@
+/// @file ToneDriverReplayer.cpp
+/// @brief Implementation of the ToneDriverReplayer class.
+
+#include "tone-driver-record/ToneDriverReplayer.h"
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <thread>
+
+static constexpr size_t HEADER_BYTES = 5; // Magic and version
+
+
+ToneDriverReplayer::ToneDriverReplayer(std::istream& log)
+    : data(std::istreambuf_iterator<char>(log), std::istreambuf_iterator<char>())
+{
+    notes.reserve(TONE_DRIVER_LOG_MAX_NOTES);
+    octaves.reserve(TONE_DRIVER_LOG_MAX_NOTES);
+}
+
+bool ToneDriverReplayer::isValid() const
+{
+    return data.size() >= HEADER_BYTES && std::memcmp(data.data(), TONE_DRIVER_LOG_MAGIC, 4) == 0 &&
+           data[4] <= TONE_DRIVER_LOG_VERSION;
+}
+
+ReplayReport ToneDriverReplayer::replay(ToneDriver& target, ReplayPacing pacing)
+{
+    ReplayReport report;
+    if (!isValid())
+    {
+        return report;
+    }
+
+    position = HEADER_BYTES;
+    readOk = true;
+
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t recordedMicros = 0;
+
+    while (position < data.size())
+    {
+        const size_t recordStart = position;
+        const ToneDriverCall call = ToneDriverCall(readByte());
+        recordedMicros += readUnsigned();
+
+        // Read every argument before making the call, so a truncated record is never half-replayed
+        float freq = 0.0f;
+        NoteName note = NoteName::C;
+        int octave = 0, count = 0, first = 0, second = 0;
+
+        switch (call)
+        {
+            case ToneDriverCall::PlayFrequency:     freq = readFloat(); break;
+            case ToneDriverCall::PlayFrequencyFor:  freq = readFloat(); first = readSigned(); break;
+            case ToneDriverCall::PlayNote:
+            case ToneDriverCall::IsValidNote:       note = NoteName(readByte()); octave = readSigned(); break;
+            case ToneDriverCall::PlayNoteFor:       note = NoteName(readByte()); octave = readSigned(); first = readSigned(); break;
+            case ToneDriverCall::PlayChord:         count = readNotes(); break;
+            case ToneDriverCall::PlayChordFor:      count = readNotes(); first = readSigned(); break;
+            case ToneDriverCall::PlayArpeggio:
+            case ToneDriverCall::PlaySequence:      count = readNotes(); first = readSigned(); second = readSigned(); break;
+            case ToneDriverCall::Stop:              break;
+            case ToneDriverCall::StopAfter:
+            case ToneDriverCall::Rest:              first = readSigned(); break;
+            default:                                readOk = false; break;
+        }
+
+        if (!readOk)
+        {
+            report.errorOffset = recordStart;
+            report.replayMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+            return report;
+        }
+
+        if (pacing == ReplayPacing::RealTime)
+        {
+            auto due = start + std::chrono::microseconds(recordedMicros);
+            auto now = std::chrono::steady_clock::now();
+            if (now < due)
+            {
+                std::this_thread::sleep_until(due);
+            }
+            else
+            {
+                float lateMs = std::chrono::duration<float, std::milli>(now - due).count();
+                report.maxLateMs = (lateMs > report.maxLateMs) ? lateMs : report.maxLateMs;
+            }
+        }
+
+        const auto callStart = std::chrono::steady_clock::now();
+
+        switch (call)
+        {
+            case ToneDriverCall::PlayFrequency:     target.playFrequency(freq); break;
+            case ToneDriverCall::PlayFrequencyFor:  target.playFrequency(freq, first); break;
+            case ToneDriverCall::PlayNote:          target.playNote(note, octave); break;
+            case ToneDriverCall::PlayNoteFor:       target.playNote(note, octave, first); break;
+            case ToneDriverCall::PlayChord:         target.playChord(notes.data(), octaves.data(), count); break;
+            case ToneDriverCall::PlayChordFor:      target.playChord(notes.data(), octaves.data(), count, first); break;
+            case ToneDriverCall::PlayArpeggio:      target.playArpeggio(notes.data(), octaves.data(), count, first, second); break;
+            case ToneDriverCall::PlaySequence:      target.playSequence(notes.data(), octaves.data(), count, first, second); break;
+            case ToneDriverCall::Stop:              target.stop(); break;
+            case ToneDriverCall::StopAfter:         target.stopAfter(first); break;
+            case ToneDriverCall::Rest:              target.rest(first); break;
+            case ToneDriverCall::IsValidNote:       target.isValidNote(note, octave); break;
+        }
+
+        float callMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - callStart).count();
+        if (callMs > report.maxCallMs)
+        {
+            report.maxCallMs = callMs;
+            report.slowestCall = size_t(report.calls);
+        }
+
+        ++report.callCounts[uint8_t(call)];
+        ++report.calls;
+    }
+
+    report.ok = true;
+    report.recordedMs = recordedMicros / 1000.0f;
+    report.replayMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+uint64_t ToneDriverReplayer::readUnsigned()
+{
+    uint64_t value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t byte = readByte();
+        value |= uint64_t(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0 || !readOk)
+        {
+            return value;
+        }
+    }
+
+    readOk = false; // Longer than any 64-bit value
+    return value;
+}
+
+int ToneDriverReplayer::readSigned()
+{
+    uint64_t value = readUnsigned();
+    return int(int64_t(value >> 1) ^ -int64_t(value & 1));
+}
+
+float ToneDriverReplayer::readFloat()
+{
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        bits |= uint32_t(readByte()) << (8 * i);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint8_t ToneDriverReplayer::readByte()
+{
+    if (position >= data.size())
+    {
+        readOk = false;
+        return 0;
+    }
+
+    return data[position++];
+}
+
+int ToneDriverReplayer::readNotes()
+{
+    int count = readSigned();
+    int recorded = (count < 0) ? 0 : (count > TONE_DRIVER_LOG_MAX_NOTES) ? TONE_DRIVER_LOG_MAX_NOTES : count;
+
+    notes.resize(recorded > 0 ? recorded : 1); // Never hand the backend a null array
+    octaves.resize(recorded > 0 ? recorded : 1);
+
+    for (int i = 0; i < recorded && readOk; ++i)
+    {
+        notes[i] = NoteName(readByte());
+        octaves[i] = readSigned();
+    }
+
+    return (count > recorded) ? recorded : count; // Never let the backend read past the arrays
+}
@@ -0,0 +1,140 @@
+/// @file AudioThread.cpp
+/// @brief Platform implementations of applyAudioThreadOptions().
+
+#include "tone-driver-sdl2/AudioThread.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif
+
+static const int HIGH_PRIORITY_NICE = -10;  ///< Nice value used for AudioThreadPriority::High.
+
+
+#if defined(_WIN32)
+// ------------------------------------------- W I N D O W S -------------------------------------------
+
+static bool setPriority(AudioThreadPriority priority)
+{
+    int level = THREAD_PRIORITY_NORMAL;
+
+    switch (priority)
+    {
+        case AudioThreadPriority::Realtime: level = THREAD_PRIORITY_TIME_CRITICAL; break;
+        case AudioThreadPriority::High:     level = THREAD_PRIORITY_HIGHEST; break;
+        default:                            break;
+    }
+
+    return SetThreadPriority(GetCurrentThread(), level) != 0;
+}
+
+static uint64_t setAffinity(uint64_t cpuMask)
+{
+    if (cpuMask != 0 && SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(cpuMask)) != 0)
+    {
+        return cpuMask;
+    }
+
+    return 0; // Windows cannot read back a thread's affinity without changing it
+}
+
+#else
+// --------------------------------------------- P O S I X ---------------------------------------------
+
+/**
+ * @brief Sets the nice value of the calling thread (Linux schedules threads individually).
+ */
+static bool setNice(int nice)
+{
+#if defined(__linux__)
+    return setpriority(PRIO_PROCESS, id_t(syscall(SYS_gettid)), nice) == 0;
+#else
+    return nice == 0; // Per-thread nice values are not supported
+#endif
+}
+
+static bool setPriority(AudioThreadPriority priority)
+{
+    sched_param param = {};
+
+    if (priority == AudioThreadPriority::Realtime)
+    {
+        int lowest = sched_get_priority_min(SCHED_FIFO);
+        int highest = sched_get_priority_max(SCHED_FIFO);
+        param.sched_priority = lowest + (highest - lowest) / 2; // Above normal threads, below the kernel's own
+
+        return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+    }
+
+    // Leave real-time scheduling, then adjust the nice value
+    param.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+
+    return setNice(priority == AudioThreadPriority::High ? HIGH_PRIORITY_NICE : 0);
+}
+
+static uint64_t setAffinity(uint64_t cpuMask)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+
+    if (cpuMask != 0)
+    {
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64; ++cpu)
+        {
+            if ((cpuMask >> cpu) & 1u) CPU_SET(cpu, &set);
+        }
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set); // Unchanged on failure
+    }
+
+    // Report what is in effect, whether or not the request succeeded
+    uint64_t achieved = 0;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0)
+    {
+        for (int cpu = 0; cpu < 64; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &set)) achieved |= uint64_t(1) << cpu;
+        }
+    }
+    return achieved;
+#else
+    (void)cpuMask;
+    return 0; // No thread affinity API (e.g. macOS)
+#endif
+}
+
+#endif
+
+
+AudioThreadStatus applyAudioThreadOptions(const AudioThreadOptions& options)
+{
+    AudioThreadStatus status;
+    status.applied = true;
+    status.priority = AudioThreadPriority::Normal;
+
+    // Try the requested priority, then each lower one
+    for (int priority = int(options.priority); priority > int(AudioThreadPriority::Normal); --priority)
+    {
+        if (setPriority(AudioThreadPriority(priority)))
+        {
+            status.priority = AudioThreadPriority(priority);
+            break;
+        }
+    }
+
+    if (status.priority == AudioThreadPriority::Normal)
+    {
+        setPriority(AudioThreadPriority::Normal);
+    }
+
+    status.cpuMask = setAffinity(options.cpuMask);
+    return status;
+}
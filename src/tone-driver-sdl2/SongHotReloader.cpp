@@ -0,0 +1,238 @@
+/// @file SongHotReloader.cpp
+/// @brief Implementation of the SongHotReloader class.
+
+#include "tone-driver-sdl2/SongHotReloader.h"
+#include <algorithm>
+#include <fstream>
+
+using SteadyClock = std::chrono::steady_clock;
+
+/**
+ * @brief Converts a steady clock duration to milliseconds.
+ */
+static float toMs(SteadyClock::duration duration)
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+
+SongHotReloader::SongHotReloader(ToneDriverSDL2& driver, const std::string& path, AudioBus bus, int amplitude)
+    : driver(driver), path(path), bus(bus), amplitude(amplitude)
+{
+}
+
+bool SongHotReloader::load()
+{
+    notes.clear();
+    offsets.assign(1, 0);
+    pcm.clear();
+    position = 0;
+
+    playing = reload();
+    lastPoll = SteadyClock::now();
+    return playing;
+}
+
+void SongHotReloader::update()
+{
+    if (!playing)
+    {
+        return;
+    }
+
+    feed();
+
+    Uint64 rendered = driver.getBusSamplesRendered(bus);
+
+    // The first chunk of the new song has been played
+    if (reportPending && report.ok && report.saveToAudibleMs < 0.0f && rendered > audibleAt)
+    {
+        report.saveToAudibleMs = toMs(SteadyClock::now() - savedAt);
+    }
+
+    // Free old renders once none of their chunks are still queued
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+        [rendered](const RetiredBuffer& buffer) { return rendered >= buffer.releaseAt; }), retired.end());
+
+    SteadyClock::time_point now = SteadyClock::now();
+    if (now - lastPoll < std::chrono::milliseconds(POLL_INTERVAL_MS))
+    {
+        return;
+    }
+    lastPoll = now;
+
+    std::error_code error;
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+
+    if (!error && writeTime != lastWriteTime && reload())
+    {
+        ++reloadCount;
+    }
+}
+
+bool SongHotReloader::pollReport(SongReloadReport& result)
+{
+    if (!reportPending || (report.ok && report.saveToAudibleMs < 0.0f))
+    {
+        return false;
+    }
+
+    result = report;
+    reportPending = false;
+    return true;
+}
+
+const SongReloadReport& SongHotReloader::getLastReport() const
+{
+    return report;
+}
+
+int SongHotReloader::getReloadCount() const
+{
+    return reloadCount;
+}
+
+void SongHotReloader::stop()
+{
+    playing = false;
+}
+
+bool SongHotReloader::reload()
+{
+    SteadyClock::time_point start = SteadyClock::now();
+    SongReloadReport next;
+
+    // Work out when the file was saved on the steady clock
+    std::error_code error;
+    lastWriteTime = std::filesystem::last_write_time(path, error);
+    savedAt = start;
+    if (!error)
+    {
+        auto sinceSave = std::filesystem::file_time_type::clock::now() - lastWriteTime;
+        savedAt = start - std::chrono::duration_cast<SteadyClock::duration>(sinceSave);
+    }
+
+    std::vector<SongNote> newNotes;
+    std::ifstream in(path);
+    next.errorLine = in.is_open() ? parseSong(in, newNotes) : 0;
+    next.parseMs = toMs(SteadyClock::now() - start);
+
+    if (!in.is_open() || next.errorLine != 0)
+    {
+        report = next; // Keep playing the old song
+        reportPending = true;
+        return false;
+    }
+
+    // Notes that are unchanged at the start and end of the song keep their samples
+    const size_t oldCount = notes.size();
+    const size_t newCount = newNotes.size();
+
+    size_t prefix = 0;
+    while (prefix < oldCount && prefix < newCount && isSameSongNote(notes[prefix], newNotes[prefix]))
+    {
+        ++prefix;
+    }
+
+    size_t suffix = 0;
+    while (suffix < oldCount - prefix && suffix < newCount - prefix &&
+           isSameSongNote(notes[oldCount - 1 - suffix], newNotes[newCount - 1 - suffix]))
+    {
+        ++suffix;
+    }
+
+    std::vector<size_t> newOffsets = getNoteOffsets(newNotes);
+    std::vector<int16_t> newPcm(newOffsets.back());
+
+    const size_t prefixEnd = newOffsets[prefix];
+    const size_t oldSuffixStart = offsets[oldCount - suffix];
+    const size_t newSuffixStart = newOffsets[newCount - suffix];
+
+    std::copy(pcm.begin(), pcm.begin() + prefixEnd, newPcm.begin());
+
+    for (size_t i = prefix; i < newCount - suffix; ++i)
+    {
+        renderSongNote(newNotes[i], ToneDriverSDL2::SAMPLE_RATE, amplitude, newPcm.data() + newOffsets[i]);
+    }
+
+    std::copy(pcm.begin() + oldSuffixStart, pcm.end(), newPcm.begin() + newSuffixStart);
+
+    // Carry on from the same place in the music
+    if (suffix > 0 && position >= oldSuffixStart)
+    {
+        position = position - oldSuffixStart + newSuffixStart;
+    }
+    if (position >= newPcm.size())
+    {
+        position = 0;
+    }
+
+    // Chunks already queued still point into the old render
+    if (!pcm.empty())
+    {
+        retired.push_back({std::move(pcm), driver.getBusSamplesQueued(bus)});
+    }
+
+    next.ok = true;
+    next.noteCount = newCount;
+    next.firstChangedNote = prefix;
+    next.changedNotes = newCount - suffix - prefix;
+    next.samplesRendered = newSuffixStart - prefixEnd;
+    next.samplesCopied = newPcm.size() - next.samplesRendered;
+
+    pcm = std::move(newPcm);
+    notes = std::move(newNotes);
+    offsets = std::move(newOffsets);
+    next.renderMs = toMs(SteadyClock::now() - start) - next.parseMs;
+
+    audibleAt = driver.getBusSamplesQueued(bus);
+    feed();
+    next.saveToQueuedMs = toMs(SteadyClock::now() - savedAt);
+
+    report = next;
+    reportPending = true;
+    return true;
+}
+
+void SongHotReloader::feed()
+{
+    if (pcm.empty())
+    {
+        return;
+    }
+
+    while (driver.getBusSamplesQueued(bus) - driver.getBusSamplesRendered(bus) < LOOKAHEAD_SAMPLES)
+    {
+        size_t count = std::min(CHUNK_SAMPLES, pcm.size() - position);
+        driver.queueSamples(bus, pcm.data() + position, int(count));
+
+        position += count;
+        if (position >= pcm.size())
+        {
+            position = 0; // Loop
+        }
+    }
+}
+
+std::vector<size_t> SongHotReloader::getNoteOffsets(const std::vector<SongNote>& song) const
+{
+    std::vector<size_t> result(song.size() + 1, 0);
+
+    for (size_t i = 0; i < song.size(); ++i)
+    {
+        result[i + 1] = result[i] + staticSongNoteSamples(song[i], ToneDriverSDL2::SAMPLE_RATE);
+    }
+
+    return result;
+}
+
+SongHotReloader::~SongHotReloader()
+{
+    // Queued chunks point into our buffers: drop them and give the callback a moment to notice
+    driver.clearBus(bus);
+
+    for (int waitedMs = 0; driver.isBusPlaying(bus) && waitedMs < 1000; ++waitedMs)
+    {
+        SDL_Delay(1);
+    }
+}
@@ -0,0 +1,244 @@
+/// @file TerminalSynth.cpp
+/// @brief Implementation of the TerminalSynth class.
+
+#include "tone-driver-sdl2/TerminalSynth.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <conio.h>
+#include <windows.h>
+#else
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+static_assert(sizeof(termios) <= 128, "TerminalSynth::savedMode is too small for struct termios");
+#endif
+
+static const int TOP_OCTAVE = 6;   ///< Highest octave the driver plays (ToneDriver::MAX_OCTAVE).
+static const char CTRL_C = 0x03;
+static const char CTRL_D = 0x04;
+
+/// @brief Keys of the tracker layout: bottom row from C of the base octave, top row from C an octave up.
+static const char* const BOTTOM_ROW = "zsxdcvgbhnjm,l.;/";
+static const char* const TOP_ROW = "q2w3er5t6y7ui9o0p";
+
+static const char* const NOTE_NAMES[12] = {"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"};
+
+
+TerminalSynth::TerminalSynth(ToneDriverSDL2& driver, int baseOctave)
+    : driver(driver), baseOctave(baseOctave)
+{
+}
+
+TerminalSynth::~TerminalSynth()
+{
+    restoreMode();
+}
+
+int TerminalSynth::run()
+{
+    enterRawMode();
+    std::cout << "Play with z s x d c v g b h n j m (octave " << baseOctave << ") and q 2 w 3 e r 5 t 6 y 7 u i (octave "
+              << baseOctave + 1 << "); - and = change octave, space releases all, Ctrl-C quits\r" << std::endl;
+
+    int notes = 0;
+
+    for (;;)
+    {
+        int key = readKey(POLL_MS);
+
+        if (key == -2 || key == CTRL_C || key == CTRL_D)
+        {
+            break;
+        }
+
+        if (key == ' ')
+        {
+            driver.allNotesOff();
+            for (HeldKey& slot : held) slot.key = 0;
+        }
+        else if (key == '-' || key == '=')
+        {
+            baseOctave += (key == '-') ? -1 : 1;
+            baseOctave = (baseOctave < 0) ? 0 : (baseOctave > TOP_OCTAVE - 1) ? TOP_OCTAVE - 1 : baseOctave;
+            std::cout << "Octave " << baseOctave << "\r" << std::endl;
+        }
+        else if (key >= 0 && pressKey(char(key)))
+        {
+            ++notes;
+        }
+
+        releaseExpired();
+        reportLatency();
+    }
+
+    // Let held notes ring out as they would have, then report the last of them
+    while (true)
+    {
+        bool sounding = false;
+        for (const HeldKey& slot : held) sounding = sounding || slot.key != 0;
+        if (!sounding) break;
+
+        SDL_Delay(POLL_MS);
+        releaseExpired();
+    }
+
+    SDL_Delay(Uint32(driver.getBufferDurationMs()) + 1);
+    reportLatency();
+    restoreMode();
+    return notes;
+}
+
+bool TerminalSynth::mapKey(char key, int baseOctave, NoteName& note, int& octave)
+{
+    const char* rows[2] = {BOTTOM_ROW, TOP_ROW};
+
+    for (int row = 0; row < 2; ++row)
+    {
+        const char* found = std::strchr(rows[row], key);
+        if (key != 0 && found != nullptr)
+        {
+            int semitone = int(found - rows[row]);
+            note = NoteName(semitone % 12);
+            octave = baseOctave + row + (semitone / 12);
+            return octave <= TOP_OCTAVE;
+        }
+    }
+
+    return false;
+}
+
+bool TerminalSynth::pressKey(char key)
+{
+    NoteName note;
+    int octave;
+    if (!mapKey(key, baseOctave, note, octave))
+    {
+        return false;
+    }
+
+    // An auto-repeat of a held key just holds the note longer
+    for (HeldKey& slot : held)
+    {
+        if (slot.key == key && slot.note == note && slot.octave == octave)
+        {
+            slot.releaseAt = Clock::now() + std::chrono::milliseconds(REPEAT_HOLD_MS);
+            return false;
+        }
+    }
+
+    for (HeldKey& slot : held)
+    {
+        if (slot.key == 0)
+        {
+            slot.key = key;
+            slot.note = note;
+            slot.octave = octave;
+            slot.releaseAt = Clock::now() + std::chrono::milliseconds(HOLD_MS);
+            driver.noteOn(note, octave);
+            return true;
+        }
+    }
+
+    return false; // Every slot is held
+}
+
+void TerminalSynth::releaseExpired()
+{
+    Clock::time_point now = Clock::now();
+
+    for (HeldKey& slot : held)
+    {
+        if (slot.key != 0 && now >= slot.releaseAt)
+        {
+            driver.noteOff(slot.note, slot.octave);
+            slot.key = 0;
+        }
+    }
+}
+
+void TerminalSynth::reportLatency()
+{
+    ToneDriverSDL2::NoteOnLatency latency = driver.getNoteOnLatency();
+    if (latency.notes == reportedNotes)
+    {
+        return;
+    }
+
+    reportedNotes = latency.notes;
+    char line[160];
+    std::snprintf(line, sizeof(line), "key to first sample %6.2f ms (mean %.2f, worst %.2f over %llu notes), buffer %.2f ms",
+                  latency.lastMs, latency.meanMs, latency.maxMs, (unsigned long long)latency.notes, driver.getBufferDurationMs());
+    std::cout << line << "\r" << std::endl;
+}
+
+#if defined(_WIN32)
+// ------------------------------------------- W I N D O W S -------------------------------------------
+
+void TerminalSynth::enterRawMode()
+{
+    rawMode = true; // The console already delivers keys one at a time through _getch()
+}
+
+void TerminalSynth::restoreMode()
+{
+    rawMode = false;
+}
+
+int TerminalSynth::readKey(int timeoutMs)
+{
+    for (int waited = 0; !_kbhit(); ++waited)
+    {
+        if (waited >= timeoutMs) return -1;
+        Sleep(1);
+    }
+
+    return _getch();
+}
+
+#else
+// --------------------------------------------- P O S I X ---------------------------------------------
+
+void TerminalSynth::enterRawMode()
+{
+    termios mode;
+    if (rawMode || !isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &mode) != 0)
+    {
+        return; // Not a terminal (e.g. a pipe): read it as it is
+    }
+
+    std::memcpy(savedMode, &mode, sizeof(mode));
+
+    // Each key as soon as it is pressed, not echoed, and Ctrl-C as a key so the mode is always restored
+    mode.c_lflag &= ~tcflag_t(ICANON | ECHO | ISIG);
+    mode.c_cc[VMIN] = 1;
+    mode.c_cc[VTIME] = 0;
+    rawMode = tcsetattr(STDIN_FILENO, TCSANOW, &mode) == 0;
+}
+
+void TerminalSynth::restoreMode()
+{
+    if (rawMode)
+    {
+        termios mode;
+        std::memcpy(&mode, savedMode, sizeof(mode));
+        tcsetattr(STDIN_FILENO, TCSANOW, &mode);
+        rawMode = false;
+    }
+}
+
+int TerminalSynth::readKey(int timeoutMs)
+{
+    pollfd input = {STDIN_FILENO, POLLIN, 0};
+    if (poll(&input, 1, timeoutMs) <= 0)
+    {
+        return -1;
+    }
+
+    unsigned char key;
+    return (read(STDIN_FILENO, &key, 1) == 1) ? key : -2;
+}
+
+#endif
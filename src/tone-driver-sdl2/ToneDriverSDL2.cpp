@@ -3,14 +3,180 @@
 
 #include <iostream>   
 #include "tone-driver-sdl2/ToneDriverSDL2.h"
+#include "tone-synth/RealtimeGuard.h"
 
-const int ToneDriverSDL2::SAMPLE_RATE = 44100;
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+const int ToneDriverSDL2::BUFFER_SAMPLES = 1024;
 const int ToneDriverSDL2::REF_FREQ = 440;
 const NoteName ToneDriverSDL2::REF_NOTE = NoteName::A;
 const int ToneDriverSDL2::REF_OCTAVE = 4;
 
 
-ToneDriverSDL2::ToneDriverSDL2()
+/**
+ * @brief Moves a gain one step towards its target without overshooting.
+ */
+static inline void rampTowards(float& value, float target, float step)
+{
+    if (value < target)
+    {
+        value = (target - value < step) ? target : value + step;
+    }
+    else if (value > target)
+    {
+        value = (value - target < step) ? target : value - step;
+    }
+}
+
+/**
+ * @brief Gets the left and right gains of a pan position (balance law: the centre is full level in both channels).
+ */
+static inline void getPanGains(float pan, float& left, float& right)
+{
+    pan = (pan > 1.0f) ? 1.0f : (pan < -1.0f) ? -1.0f : pan;
+    left = (pan > 0.0f) ? 1.0f - pan : 1.0f;
+    right = (pan < 0.0f) ? 1.0f + pan : 1.0f;
+}
+
+/**
+ * @brief Adds a mono bus to interleaved stereo frames, ramping its left and right gains across the chunk.
+ */
+static void mixPanned(const float* bus, float* frames, int count, float left, float right, float leftEnd, float rightEnd)
+{
+    const float leftStep = (leftEnd - left) / count;
+    const float rightStep = (rightEnd - right) / count;
+    int i = 0;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    __m128 index = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 four = _mm_set1_ps(4.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 gainLeft = _mm_add_ps(_mm_set1_ps(left), _mm_mul_ps(index, _mm_set1_ps(leftStep)));
+        __m128 gainRight = _mm_add_ps(_mm_set1_ps(right), _mm_mul_ps(index, _mm_set1_ps(rightStep)));
+        __m128 x = _mm_loadu_ps(bus + i);
+        __m128 l = _mm_mul_ps(x, gainLeft);
+        __m128 r = _mm_mul_ps(x, gainRight);
+
+        // Interleave four samples into L R L R | L R L R
+        float* out = frames + (2 * i);
+        _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_unpacklo_ps(l, r)));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_unpackhi_ps(l, r)));
+        index = _mm_add_ps(index, four);
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        frames[2 * i] += bus[i] * (left + (i * leftStep));
+        frames[(2 * i) + 1] += bus[i] * (right + (i * rightStep));
+    }
+}
+
+/**
+ * @brief Scales and clips mixed frames and writes them straight into the device buffer in its format.
+ *
+ * @param mix         Mixed frames of mixChannels samples.
+ * @param mixChannels Samples per mixed frame (1 or 2).
+ * @param frames      Number of frames.
+ * @param amplitude   Output volume.
+ * @param out         First byte of the frames in the device buffer.
+ * @param outChannels Samples per device frame. Channels beyond mixChannels are silent.
+ * @param isFloat     True for 32-bit float samples, false for 16-bit.
+ */
+static void writeFrames(const float* mix, int mixChannels, int frames, float amplitude, Uint8* out, int outChannels, bool isFloat)
+{
+    Sint16* out16 = (Sint16*)out;
+    float* outFloat = (float*)out;
+
+    if (outChannels != mixChannels)
+    {
+        // Multichannel: the mix goes to the front pair, the rest are silent
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            for (int channel = 0; channel < outChannels; ++channel)
+            {
+                float sample = (channel < mixChannels) ? amplitude * mix[(frame * mixChannels) + channel] : 0.0f;
+                sample = (sample > 1.0f) ? 1.0f : (sample < -1.0f) ? -1.0f : sample;
+
+                if (isFloat) outFloat[(frame * outChannels) + channel] = sample;
+                else out16[(frame * outChannels) + channel] = (Sint16)(32767 * sample);
+            }
+        }
+        return;
+    }
+
+    const int count = frames * mixChannels;
+    int i = 0;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    const __m128 gain = _mm_set1_ps(amplitude);
+    const __m128 high = _mm_set1_ps(1.0f);
+    const __m128 low = _mm_set1_ps(-1.0f);
+    const __m128 fullScale = _mm_set1_ps(32767.0f);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        // Clip the sum of the buses
+        __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(mix + i), gain), low), high);
+        __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(mix + i + 4), gain), low), high);
+
+        if (isFloat)
+        {
+            _mm_storeu_ps(outFloat + i, a);
+            _mm_storeu_ps(outFloat + i + 4, b);
+        }
+        else
+        {
+            __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(_mm_mul_ps(a, fullScale)), _mm_cvttps_epi32(_mm_mul_ps(b, fullScale)));
+            _mm_storeu_si128((__m128i*)(out16 + i), packed);
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float sample = amplitude * mix[i];
+        sample = (sample > 1.0f) ? 1.0f : (sample < -1.0f) ? -1.0f : sample; // Clip the sum of the buses
+
+        if (isFloat) outFloat[i] = sample;
+        else out16[i] = (Sint16)(32767 * sample);
+    }
+}
+
+
+ToneDriverSDL2::ToneDriverSDL2(AudioInitMode initMode, int channels, int requestedBufferSamples)
+{
+    constructTicks = SDL_GetPerformanceCounter();
+    outputChannels = (channels < 1) ? 1 : (channels > MAX_CHANNELS) ? MAX_CHANNELS : channels;
+    bufferSamples = (requestedBufferSamples > 0 && requestedBufferSamples <= 0xFFFF) ? requestedBufferSamples : BUFFER_SAMPLES;
+    WavetableBank::get(); // Built here so the callback never allocates them
+
+    // Effects duck the music rather than overwriting it
+    AudioBusSettings music;
+    music.duckGain = 0.3f;
+    setBusSettings(AudioBus::Music, music);
+
+    AudioBusSettings effects;
+    effects.priority = 1;
+    setBusSettings(AudioBus::Effects, effects);
+
+    if (initMode == AudioInitMode::Background)
+    {
+        initThread = std::thread(&ToneDriverSDL2::openDevice, this); // Play calls are held until the device is ready
+    }
+    else
+    {
+        openDevice();
+    }
+
+    constructedTicks = SDL_GetPerformanceCounter();
+}
+
+void ToneDriverSDL2::openDevice()
 {
     if (SDL_Init(SDL_INIT_AUDIO) < 0) {
         std::cerr << "SDL_Init failed: " << SDL_GetError() << std::endl;
@@ -21,39 +187,103 @@ ToneDriverSDL2::ToneDriverSDL2()
     SDL_zero(spec);
     spec.freq = SAMPLE_RATE;
     spec.format = AUDIO_S16SYS;
-    spec.channels = 1;
-    spec.samples = 1024;
+    spec.channels = Uint8(outputChannels.load());
+    spec.samples = Uint16(bufferSamples.load());
     spec.callback = audioCallback;
     spec.userdata = this; 
 
-    if (SDL_OpenAudio(&spec, NULL) < 0) {
+    SDL_AudioSpec obtained;
+    SDL_zero(obtained);
+
+    if (SDL_OpenAudio(&spec, &obtained) < 0) {
         std::cerr << "SDL_OpenAudio failed: " << SDL_GetError() << std::endl;
         //return 1;
     }
+    else if (obtained.format != AUDIO_S16SYS && obtained.format != AUDIO_F32SYS)
+    {
+        // A format the mixer doesn't write: reopen and let SDL convert from 16-bit
+        SDL_CloseAudio();
+        spec.channels = obtained.channels;
+        obtained = spec;
+        if (SDL_OpenAudio(&spec, nullptr) < 0) {
+            std::cerr << "SDL_OpenAudio failed: " << SDL_GetError() << std::endl;
+        }
+    }
+
+    if (obtained.samples > 0)
+    {
+        bufferSamples = obtained.samples;
+    }
+    if (obtained.channels > 0)
+    {
+        outputChannels = obtained.channels; // Rendered as obtained, so SDL needn't convert
+    }
+    floatOutput = (obtained.format == AUDIO_F32SYS);
+
+    // Apply any play or stop requested while the device was opening
+    std::lock_guard<std::mutex> lock(deviceMutex);
+    deviceReady = true;
+    deviceReadyTicks = SDL_GetPerformanceCounter();
+    SDL_PauseAudio(deviceRunning ? 0 : 1);
+    deviceReadyCondition.notify_all();
+}
+
+void ToneDriverSDL2::setDevicePaused(bool paused)
+{
+    std::lock_guard<std::mutex> lock(deviceMutex);
+    if (!paused && !deviceRunning)
+    {
+        deviceStarts.fetch_add(1, std::memory_order_release); // The next callback interval spans a pause
+    }
+    deviceRunning = !paused;
+
+    if (deviceReady)
+    {
+        SDL_PauseAudio(paused ? 1 : 0);
+    }
+}
+
+void ToneDriverSDL2::waitForDevice()
+{
+    std::unique_lock<std::mutex> lock(deviceMutex);
+    deviceReadyCondition.wait(lock, [this] { return deviceReady; });
 }
 
 void ToneDriverSDL2::playFrequency(float freq)
 {
-    timeIndex = 0;          // Reset playback phase
     setNoteFrequency(freq); // Set the note frequency
-    SDL_PauseAudio(0);      // Start audio playback
+    startTone();            // Start audio playback
 }
 
 void ToneDriverSDL2::playFrequency(float freq, int durationMs)
 {
-    timeIndex = 0;          // Reset playback phase 
     setNoteFrequency(freq); // Set the note frequency
-    SDL_PauseAudio(0);      // Start audio playback
+    startTone();            // Start audio playback
     stopAfter(durationMs);  // Stop audio playback after a given duration
 }
 
+void ToneDriverSDL2::playFrequency(float freq, int durationMs, const ToneAutomation& automation)
+{
+    startSequence();
+    queueStep(FOREGROUND_BUS, freq, durationMs, automation); // Automation is evaluated by the callback
+    finishSequence();
+}
+
+void ToneDriverSDL2::playSweep(float startFreq, float endFreq, int durationMs, GlideCurve curve)
+{
+    ToneAutomation sweep;
+    sweep.glideToFrequency = endFreq;
+    sweep.glideCurve = curve;
+
+    playFrequency(startFreq, durationMs, sweep);
+}
+
 void ToneDriverSDL2::playNote(NoteName note, int octave)
 {
     if (isValidNote(note, octave))
     {
-        timeIndex = 0;                  // Reset playback phase
         setNoteFrequency(note, octave); // Set the note frequency
-        SDL_PauseAudio(0);              // Start audio playback
+        startTone();                    // Start audio playback
     }
 }
 
@@ -61,21 +291,55 @@ void ToneDriverSDL2::playNote(NoteName note, int octave, int durationMs)
 {  
     if (isValidNote(note, octave))
     {
-        timeIndex = 0;                  // Reset playback phase 
         setNoteFrequency(note, octave); // Set the note frequency
-        SDL_PauseAudio(0);              // Start audio playback
+        startTone();                    // Start audio playback
         stopAfter(durationMs);          // Stop audio playback after a given duration
     }
 }
 
+void ToneDriverSDL2::playNote(NoteName note, int octave, int durationMs, const ToneAutomation& automation)
+{
+    if (isValidNote(note, octave))
+    {
+        playFrequency(getNoteFrequency(note, octave), durationMs, automation);
+    }
+}
+
 void ToneDriverSDL2::playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count)
 {
     playArpeggio(notes, octaves, count, DEFAULT_CHORD_ARPEGGIO_DELAY_MS);
 }
 
+void ToneDriverSDL2::playChord(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int durationMs)
+{
+    if (!isValidNoteCount(count))
+    {
+        return;
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        if (!isValidNote(notes[i], octaves[i]))
+        {
+            return;
+        }
+    }
+
+    startSequence();
+
+    // Cycle through the chord tones for the whole duration
+    for (int elapsedMs = 0, i = 0; elapsedMs < durationMs; elapsedMs += DEFAULT_CHORD_ARPEGGIO_DELAY_MS, i = (i + 1) % count)
+    {
+        int stepMs = (durationMs - elapsedMs < DEFAULT_CHORD_ARPEGGIO_DELAY_MS) ? durationMs - elapsedMs : DEFAULT_CHORD_ARPEGGIO_DELAY_MS;
+        queueStep(FOREGROUND_BUS, getNoteFrequency(notes[i], octaves[i]), stepMs);
+    }
+
+    finishSequence();
+}
+
 void ToneDriverSDL2::playArpeggio(const NoteName notes[MAX_POLYPHONY], const int octaves[MAX_POLYPHONY], int count, int noteDurationMs, int delayMs)
 {
-    if(count > 0 && count <= MAX_POLYPHONY)
+    if (isValidNoteCount(count))
     {
         for(int i = 0; i < count; ++i)
         {
@@ -83,88 +347,980 @@ void ToneDriverSDL2::playArpeggio(const NoteName notes[MAX_POLYPHONY], const int
             rest(delayMs);                              
         }
     }
-    else
+}
+
+void ToneDriverSDL2::playSequence(const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    startSequence();
+
+    for (int i = 0; i < count; ++i)
     {
-        std::cerr << count << " is not a valid number of notes! Chords and arpeggios can have between 1 and " << MAX_POLYPHONY << " notes." << std::endl;
+        if (isValidNote(notes[i], octaves[i]))
+        {
+            queueStep(FOREGROUND_BUS, getNoteFrequency(notes[i], octaves[i]), noteDurationMs);
+            queueStep(FOREGROUND_BUS, 0.0f, restMs);
+        }
     }
+
+    finishSequence();
 }
 
-void ToneDriverSDL2::stop()
+void ToneDriverSDL2::startSequence()
 {
-    SDL_PauseAudio(1);     // Pause audio playback
-    //SDL_CloseAudio();    // Stop audio playback
+    // Start the device first so a long run can drain while the rest is being queued
+    gateOpen = false;
+    setDevicePaused(false);
 }
 
-void ToneDriverSDL2::stopAfter(int durationMs)
+void ToneDriverSDL2::finishSequence()
 {
-    SDL_Delay(durationMs); // Play for the given duration (blocks thread. Aim to either use non-blocking timer or spawn thread to sleep and then call stop) (SDL_AddTimer()?)
-    stop();                // Stop audio playback
+    // Block until the callback has rendered the whole run, like the other timed calls
+    while (hasQueuedSamples(FOREGROUND_BUS))
+    {
+        SDL_Delay(1);
+    }
+
+    stop();
+    diagnostics.flush(); // Already blocked, so print any logged errors here
 }
 
-void ToneDriverSDL2::rest(int durationMs)
+bool ToneDriverSDL2::isValidNoteCount(int count)
 {
-    stop();                   // Stop audio playback
-    SDL_Delay(durationMs);    // Wait for a given delay (Temporary solution - might implement with non-blocking timer)
+    if (count > 0 && count <= MAX_POLYPHONY)
+    {
+        return true;
+    }
+
+    diagnostics.report(DiagnosticCode::InvalidNoteCount, count, MAX_POLYPHONY);
+    return false;
 }
 
-void ToneDriverSDL2::audioCallback(void* userdata, Uint8* stream, int len)
+void ToneDriverSDL2::queueStep(int index, float frequency, int durationMs, const ToneAutomation& automation)
 {
-    auto* driver = static_cast<ToneDriverSDL2*>(userdata);
-    driver->generateSquareWave(stream, len);
+    if (durationMs <= 0)
+    {
+        return;
+    }
+
+    pushStep(index, {frequency, Uint32((Uint64(durationMs) * SAMPLE_RATE) / 1000), nullptr, automation});
 }
 
-void ToneDriverSDL2::generateSquareWave(Uint8* stream, int len)
+void ToneDriverSDL2::pushStep(int index, const SequenceStep& step)
 {
-    Sint16* buffer = (Sint16*)stream;
-    int samples = len / 2; // 2 bytes per sample (16-bit audio)
+    Bus& target = buses[index];
+
+    if (!target.steps.push(step))
+    {
+        setDevicePaused(false); // Queue full: only a running device can drain it
 
-    for (int i = 0; i < samples; ++i, ++timeIndex) {
-        double t = (double)timeIndex / SAMPLE_RATE;
-        double wave = (sin(2.0 * M_PI * currentFrequency * t) > 0) ? 1.0 : -1.0;
-        buffer[i] = (Sint16)(32767 * currentAmplitude * wave);
+        while (!target.steps.push(step))
+        {
+            SDL_Delay(1); // Wait for the callback to consume some steps
+        }
     }
+
+    target.samplesQueued.fetch_add(step.samples, std::memory_order_release);
 }
 
-int ToneDriverSDL2::getSemitonesDiff(NoteName note1, int octave1, NoteName note2, int octave2)
+void ToneDriverSDL2::queueNote(AudioBus bus, NoteName note, int octave, int durationMs, const ToneAutomation& automation)
 {
-    return (int(note2) + (12 * octave2)) - (int(note1) + (12 * octave1));
+    if (isValidNote(note, octave))
+    {
+        queueFrequency(bus, getNoteFrequency(note, octave), durationMs, automation);
+    }
 }
 
-void ToneDriverSDL2::setNoteFrequency(float freq)
+void ToneDriverSDL2::queueFrequency(AudioBus bus, float freq, int durationMs, const ToneAutomation& automation)
 {
-    currentFrequency = freq;
+    queueStep(int(bus), freq, durationMs, automation);
+    setDevicePaused(false);
 }
 
-void ToneDriverSDL2::setNoteFrequency(NoteName note, int octave)
+void ToneDriverSDL2::queueRest(AudioBus bus, int durationMs)
 {
-    // should isValidNote be happening in here rather than in playNote?
-    currentFrequency = REF_FREQ * pow(2, getSemitonesDiff(REF_NOTE, REF_OCTAVE, note, octave) / 12.0);
+    queueStep(int(bus), 0.0f, durationMs);
+    setDevicePaused(false);
 }
 
-void ToneDriverSDL2::setAmplitude(float amplitude)
+void ToneDriverSDL2::queueSequence(AudioBus bus, const NoteName notes[], const int octaves[], int count, int noteDurationMs, int restMs)
 {
-    if (amplitude < 0.0f) amplitude = 0.0f;
-    if (amplitude > 1.0f) amplitude = 1.0f;
-    currentAmplitude = amplitude;
+    for (int i = 0; i < count; ++i)
+    {
+        if (isValidNote(notes[i], octaves[i]))
+        {
+            queueStep(int(bus), getNoteFrequency(notes[i], octaves[i]), noteDurationMs);
+            queueStep(int(bus), 0.0f, restMs);
+        }
+    }
+
+    setDevicePaused(false);
 }
 
-bool ToneDriverSDL2::isValidNote(NoteName note, int octave)
+void ToneDriverSDL2::noteOn(NoteName note, int octave)
 {
-    if (note < NoteName::C || note > NoteName::B) {
-        std::cerr << int(note) << " is not a valid note! Notes range from 0 to 11 (C to B)" << std::endl;
-        return false;
+    if (isValidNote(note, octave))
+    {
+        pushLiveEvent({getNoteFrequency(note, octave), (octave * 12) + int(note), true, SDL_GetPerformanceCounter()});
+        setDevicePaused(false);
     }
-    if (octave < 0 || octave > MAX_OCTAVE) {
-        std::cerr << octave << " is not a valid octave! Octaves range from 0 to " << MAX_OCTAVE << std::endl;
-        return false;
+}
+
+void ToneDriverSDL2::noteOff(NoteName note, int octave)
+{
+    if (isValidNote(note, octave))
+    {
+        pushLiveEvent({0.0f, (octave * 12) + int(note), false, SDL_GetPerformanceCounter()});
     }
+}
 
-    return true;
+void ToneDriverSDL2::allNotesOff()
+{
+    pushLiveEvent({0.0f, -1, false, SDL_GetPerformanceCounter()});
 }
 
-ToneDriverSDL2::~ToneDriverSDL2()
+void ToneDriverSDL2::pushLiveEvent(const LiveEvent& event)
 {
-    // Shut down the SDL audio subsystem
-    SDL_CloseAudio();
-    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    while (!liveEvents.push(event))
+    {
+        SDL_Delay(1); // Queue full: wait for the callback to take some events
+    }
+}
+
+ToneDriverSDL2::NoteOnLatency ToneDriverSDL2::getNoteOnLatency() const
+{
+    const double msPerTick = 1000.0 / SDL_GetPerformanceFrequency();
+    Uint64 notes = noteOnLatencyCount.load(std::memory_order_acquire);
+
+    NoteOnLatency latency;
+    latency.notes = notes;
+    latency.lastMs = float(msPerTick * noteOnLatencyLastTicks.load(std::memory_order_relaxed));
+    latency.meanMs = (notes > 0) ? float(msPerTick * noteOnLatencyTotalTicks.load(std::memory_order_relaxed) / notes) : 0.0f;
+    latency.maxMs = float(msPerTick * noteOnLatencyMaxTicks.load(std::memory_order_relaxed));
+    return latency;
+}
+
+void ToneDriverSDL2::queueNoise(AudioBus bus, const NoiseHit& hit)
+{
+    if (hit.durationMs <= 0)
+    {
+        return;
+    }
+
+    SequenceStep step = {hit.clockHz, Uint32((Uint64(hit.durationMs) * SAMPLE_RATE) / 1000), nullptr, ToneAutomation()};
+    step.noise = true;
+    step.noiseHit = hit;
+
+    pushStep(int(bus), step);
+    setDevicePaused(false);
+}
+
+void ToneDriverSDL2::queueSamples(AudioBus bus, const Sint16* samples, int count)
+{
+    if (samples == nullptr || count <= 0)
+    {
+        return;
+    }
+
+    pushStep(int(bus), {0.0f, Uint32(count), samples, ToneAutomation()});
+    setDevicePaused(false);
+}
+
+void ToneDriverSDL2::queueLoop(AudioBus bus, const Sint16* samples, int count, int loopStart, int loopEnd)
+{
+    if (samples == nullptr || count <= 0)
+    {
+        return;
+    }
+
+    if (loopEnd <= 0 || loopEnd > count) loopEnd = count;
+    if (loopStart < 0 || loopStart >= loopEnd) loopStart = 0;
+
+    SequenceStep step = {0.0f, Uint32(count), samples, ToneAutomation()};
+    step.loopStart = Uint32(loopStart);
+    step.loopEnd = Uint32(loopEnd);
+
+    pushStep(int(bus), step);
+    setDevicePaused(false);
+}
+
+void ToneDriverSDL2::releaseLoop(AudioBus bus)
+{
+    buses[int(bus)].loopReleases.fetch_add(1, std::memory_order_release); // Seen by the callback at the loop end
+}
+
+void ToneDriverSDL2::clearBus(AudioBus bus)
+{
+    buses[int(bus)].clearRequests.fetch_add(1, std::memory_order_release); // Dropped by the next callback
+}
+
+bool ToneDriverSDL2::isBusPlaying(AudioBus bus) const
+{
+    return hasQueuedSamples(int(bus));
+}
+
+bool ToneDriverSDL2::hasQueuedSamples(int index) const
+{
+    const Bus& target = buses[index];
+    return target.samplesRendered.load(std::memory_order_acquire) < target.samplesQueued.load(std::memory_order_acquire);
+}
+
+Uint64 ToneDriverSDL2::getBusSamplesQueued(AudioBus bus) const
+{
+    return buses[int(bus)].samplesQueued.load(std::memory_order_acquire);
+}
+
+Uint64 ToneDriverSDL2::getBusSamplesRendered(AudioBus bus) const
+{
+    return buses[int(bus)].samplesRendered.load(std::memory_order_acquire);
+}
+
+void ToneDriverSDL2::waitForBus(AudioBus bus)
+{
+    while (isBusPlaying(bus))
+    {
+        SDL_Delay(1);
+    }
+}
+
+void ToneDriverSDL2::setBusSettings(AudioBus bus, const AudioBusSettings& settings)
+{
+    applyBusSettings(buses[int(bus)], settings);
+
+    if (bus == AudioBus::Music)
+    {
+        applyBusSettings(buses[FOREGROUND_BUS], settings); // The blocking calls sound like the music bus
+    }
+}
+
+void ToneDriverSDL2::applyBusSettings(Bus& target, const AudioBusSettings& settings)
+{
+    target.gain = settings.gain;
+    target.priority = settings.priority;
+    target.duckGain = settings.duckGain;
+    target.pauseWhenPreempted = settings.pauseWhenPreempted;
+    target.pan = settings.pan;
+    target.waveform = int(settings.waveform);
+    target.pulseWidth = settings.pulseWidth;
+}
+
+AudioBusSettings ToneDriverSDL2::getBusSettings(AudioBus bus) const
+{
+    const Bus& target = buses[int(bus)];
+
+    AudioBusSettings settings;
+    settings.gain = target.gain;
+    settings.priority = target.priority;
+    settings.duckGain = target.duckGain;
+    settings.pauseWhenPreempted = target.pauseWhenPreempted;
+    settings.pan = target.pan;
+    settings.waveform = Waveform(target.waveform.load());
+    settings.pulseWidth = target.pulseWidth;
+    return settings;
+}
+
+void ToneDriverSDL2::playSamples(const Sint16* samples, int count)
+{
+    if (samples == nullptr || count <= 0)
+    {
+        return;
+    }
+
+    startSequence();
+    pushStep(FOREGROUND_BUS, {0.0f, Uint32(count), samples, ToneAutomation()});
+    finishSequence();
+}
+
+void ToneDriverSDL2::stop()
+{
+    gateOpen = false;      // Silence the output from the next sample onwards
+
+    if (!warmDevice && !hasPendingWork()) // Let queued music, loops, effects and live notes play on
+    {
+        setDevicePaused(true); // Pause audio playback
+    }
+    //SDL_CloseAudio();    // Stop audio playback
+}
+
+bool ToneDriverSDL2::hasPendingWork() const
+{
+    for (int i = 0; i < MIX_BUS_COUNT; ++i)
+    {
+        if (hasQueuedSamples(i)) return true;
+    }
+
+    // Loops past their first pass and live notes are only known to the callback
+    return !liveEvents.empty() || busesSounding.load(std::memory_order_acquire);
+}
+
+void ToneDriverSDL2::stopAfter(int durationMs)
+{
+    waitForDevice();       // A note requested before the device opened still plays for its full duration
+    SDL_Delay(durationMs); // Play for the given duration (blocks thread. Aim to either use non-blocking timer or spawn thread to sleep and then call stop) (SDL_AddTimer()?)
+    stop();                // Stop audio playback
+    diagnostics.flush();   // Print any logged errors while the caller is blocked anyway
+}
+
+void ToneDriverSDL2::rest(int durationMs)
+{
+    stop();                   // Stop audio playback
+    SDL_Delay(durationMs);    // Wait for a given delay (Temporary solution - might implement with non-blocking timer)
+    diagnostics.flush();      // Print any logged errors while the caller is blocked anyway
+}
+
+void ToneDriverSDL2::audioCallback(void* userdata, Uint8* stream, int len)
+{
+    RealtimeGuard guard; // Counts any allocation or lock in checked builds
+    Uint64 startTicks = SDL_GetPerformanceCounter();
+
+    auto* driver = static_cast<ToneDriverSDL2*>(userdata);
+    driver->applyThreadOptions();
+    driver->generateSquareWave(stream, len);
+    driver->recordCallbackTiming(startTicks, SDL_GetPerformanceCounter());
+}
+
+void ToneDriverSDL2::recordCallbackTiming(Uint64 startTicks, Uint64 endTicks)
+{
+    unsigned resets = callbackTimingResets.load(std::memory_order_acquire);
+    if (resets != callbackTimingResetsApplied)
+    {
+        callbackTimingResetsApplied = resets;
+        callbackCount.store(0, std::memory_order_relaxed);
+        callbackIntervals.store(0, std::memory_order_relaxed);
+        callbackIntervalTicks.store(0, std::memory_order_relaxed);
+        maxCallbackIntervalTicks.store(0, std::memory_order_relaxed);
+        callbackRenderTicks.store(0, std::memory_order_relaxed);
+        maxCallbackRenderTicks.store(0, std::memory_order_relaxed);
+        lastCallbackTicks = 0;
+    }
+
+    // Only this thread writes the counters, so plain loads and stores are enough
+    unsigned starts = deviceStarts.load(std::memory_order_acquire);
+    if (lastCallbackTicks != 0 && starts == timedDeviceStarts)
+    {
+        Uint64 interval = startTicks - lastCallbackTicks;
+        callbackIntervals.store(callbackIntervals.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        callbackIntervalTicks.store(callbackIntervalTicks.load(std::memory_order_relaxed) + interval, std::memory_order_relaxed);
+        if (interval > maxCallbackIntervalTicks.load(std::memory_order_relaxed))
+        {
+            maxCallbackIntervalTicks.store(interval, std::memory_order_relaxed);
+        }
+    }
+    timedDeviceStarts = starts;
+    lastCallbackTicks = startTicks;
+
+    Uint64 render = endTicks - startTicks;
+    callbackRenderTicks.store(callbackRenderTicks.load(std::memory_order_relaxed) + render, std::memory_order_relaxed);
+    if (render > maxCallbackRenderTicks.load(std::memory_order_relaxed))
+    {
+        maxCallbackRenderTicks.store(render, std::memory_order_relaxed);
+    }
+    callbackCount.store(callbackCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void ToneDriverSDL2::applyThreadOptions()
+{
+    unsigned version = threadOptionsVersion.load(std::memory_order_acquire);
+    if (version == appliedThreadOptionsVersion)
+    {
+        return;
+    }
+
+    AudioThreadOptions options;
+    options.priority = AudioThreadPriority(requestedThreadPriority.load(std::memory_order_relaxed));
+    options.cpuMask = requestedCpuMask.load(std::memory_order_relaxed);
+
+    AudioThreadStatus status = applyAudioThreadOptions(options); // Must run on the callback thread
+
+    achievedThreadPriority.store(int(status.priority), std::memory_order_relaxed);
+    achievedCpuMask.store(status.cpuMask, std::memory_order_relaxed);
+    appliedThreadOptionsVersion = version;
+    threadOptionsApplied.store(version == threadOptionsVersion.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+void ToneDriverSDL2::markFirstSample()
+{
+    if (firstSampleTicks.load(std::memory_order_relaxed) == 0)
+    {
+        firstSampleTicks.store(SDL_GetPerformanceCounter(), std::memory_order_relaxed);
+    }
+}
+
+void ToneDriverSDL2::startTone()
+{
+    noteOnTicks.store(SDL_GetPerformanceCounter(), std::memory_order_relaxed);
+    noteOnCount.fetch_add(1, std::memory_order_release); // Callback resets the phase and records the onset
+    gateOpen = true;
+
+    if (!warmDevice)
+    {
+        setDevicePaused(false); // Start audio playback
+    }
+}
+
+void ToneDriverSDL2::generateSquareWave(Uint8* stream, int len)
+{
+    const int channels = outputChannels.load(std::memory_order_relaxed);
+    const bool isFloat = floatOutput.load(std::memory_order_relaxed);
+    const int frameBytes = channels * (isFloat ? int(sizeof(float)) : int(sizeof(Sint16)));
+    const int mixChannels = (channels == 1) ? 1 : 2; // Mono ignores pan
+    int frames = len / frameBytes;
+    float amplitude = currentAmplitude;
+    float busMix[MIX_CHUNK];
+    float mix[MIX_CHUNK * 2];   // Interleaved like the device buffer
+
+    for (int offset = 0; offset < frames; offset += MIX_CHUNK)
+    {
+        int count = (frames - offset < MIX_CHUNK) ? frames - offset : MIX_CHUNK;
+        SDL_memset(mix, 0, count * mixChannels * sizeof(float));
+
+        // Buses below the highest sounding priority are ducked or paused
+        bool active[MIX_BUS_COUNT];
+        bool anyActive = false;
+        int topPriority = 0;
+
+        applyLiveEvents();
+        bool sounding = false;
+
+        for (int i = 0; i < MIX_BUS_COUNT; ++i)
+        {
+            applyBusClear(buses[i]);
+            active[i] = isBusActive(i);
+            sounding = sounding || hasStepWork(buses[i]);
+
+            int priority = buses[i].priority.load(std::memory_order_relaxed);
+            if (active[i] && (!anyActive || priority > topPriority))
+            {
+                topPriority = priority;
+            }
+            anyActive = anyActive || active[i];
+        }
+
+        for (const LiveNote& live : liveNotes)
+        {
+            sounding = sounding || live.voice != nullptr;
+        }
+        busesSounding.store(sounding, std::memory_order_release);
+
+        for (int i = 0; i < MIX_BUS_COUNT; ++i)
+        {
+            bool preempted = active[i] && buses[i].priority.load(std::memory_order_relaxed) < topPriority;
+
+            if (mixChannels == 1)
+            {
+                renderBus(i, mix, count, preempted);
+                continue;
+            }
+
+            // Render the bus in mono, then pan it into the frames, ramping from the last chunk's gains
+            SDL_memset(busMix, 0, count * sizeof(float));
+            renderBus(i, busMix, count, preempted);
+
+            Bus& bus = buses[i];
+            float left, right;
+            getPanGains(bus.pan.load(std::memory_order_relaxed), left, right);
+            if (!bus.wasActive)
+            {
+                bus.panLeft = left;   // Nothing was sounding, so there is nothing to ramp from
+                bus.panRight = right;
+            }
+            mixPanned(busMix, mix, count, bus.panLeft, bus.panRight, left, right);
+            bus.panLeft = left;
+            bus.panRight = right;
+            bus.wasActive = active[i];
+        }
+
+        writeFrames(mix, mixChannels, count, amplitude, stream + (offset * frameBytes), channels, isFloat);
+    }
+}
+
+void ToneDriverSDL2::renderBus(int index, float* mix, int samples, bool preempted)
+{
+    Bus& bus = buses[index];
+
+    if (preempted && bus.pauseWhenPreempted.load(std::memory_order_relaxed))
+    {
+        return; // Hold this bus's place until the higher-priority bus is silent
+    }
+
+    const float gain = bus.gain.load(std::memory_order_relaxed);
+    const float duckTarget = preempted ? bus.duckGain.load(std::memory_order_relaxed) : 1.0f;
+    Uint64 stepSamples = 0;
+    int ducked = samples; // Samples over which the ducking gain has been ramped
+    bool audible = false; // Rests and gaps don't count as the first sample
+
+    for (int i = 0; i < samples; ++i)
+    {
+        // At the loop end, jump back to the loop start unless the loop has been released
+        if (bus.step.loopEnd > 0 && bus.step.samples - bus.remaining == bus.step.loopEnd)
+        {
+            unsigned releases = bus.loopReleases.load(std::memory_order_acquire);
+            if (releases == bus.loopReleasesApplied)
+            {
+                if (!bus.replaying)
+                {
+                    stepSamples += bus.remaining; // The first pass counts the whole buffer as rendered
+                    bus.replaying = true;
+                }
+                bus.remaining = bus.step.samples - bus.step.loopStart;
+            }
+            else
+            {
+                bus.loopReleasesApplied = releases;
+                bus.step.loopEnd = 0; // Play on to the end of the buffer
+            }
+        }
+
+        if (bus.remaining == 0 && !nextStep(bus))
+        {
+            // Queue empty: the foreground bus falls back to the gated tone
+            ducked = i;
+            if (index == FOREGROUND_BUS)
+            {
+                ducked += mixGatedTone(bus, mix + i, samples - i, duckTarget);
+            }
+            break;
+        }
+
+        --bus.remaining;
+        stepSamples += bus.replaying ? 0 : 1;
+
+        rampTowards(bus.duck, duckTarget, DUCK_RAMP_STEP);
+
+        float sample = 0.0f;
+        if (bus.step.pcm != nullptr)
+        {
+            sample = bus.step.pcm[bus.step.samples - bus.remaining - 1] / 32767.0f; // Read in place
+            audible = true;
+        }
+        else if (bus.voice != nullptr)
+        {
+            sample = bus.voice->nextSample();
+            audible = true;
+        }
+        else if (bus.noise != nullptr)
+        {
+            sample = bus.noise->nextSample() / 32767.0f;
+            audible = true;
+        }
+
+        mix[i] += gain * bus.duck * sample;
+    }
+
+    if (audible)
+    {
+        markFirstSample();
+    }
+
+    if (index == int(AudioBus::Music))
+    {
+        // Live notes follow the ducking a chunk at a time
+        rampTowards(bus.duck, duckTarget, DUCK_RAMP_STEP * (samples - ducked));
+        mixLiveNotes(bus, mix, samples);
+    }
+
+    bus.samplesRendered.fetch_add(stepSamples, std::memory_order_release);
+}
+
+int ToneDriverSDL2::mixGatedTone(Bus& bus, float* mix, int samples, float duckTarget)
+{
+    if (!gateOpen)
+    {
+        releaseVoice(gateVoice);
+        return 0;
+    }
+
+    // A new note has started since the last buffer: restart its phase and time its onset
+    unsigned noteOns = noteOnCount.load(std::memory_order_acquire);
+    if (noteOns != renderedNoteOnCount || gateVoice == nullptr)
+    {
+        if (gateVoice == nullptr && !acquireVoice(gateVoice))
+        {
+            return 0;
+        }
+
+        renderedNoteOnCount = noteOns;
+        gateVoice->start(currentFrequency, SAMPLE_RATE);
+        applyWaveform(bus, *gateVoice);
+        onsetLatencyTicks.store(SDL_GetPerformanceCounter() - noteOnTicks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        onsetMeasured = true;
+    }
+
+    gateVoice->setFrequency(currentFrequency);
+    const float gain = bus.gain.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < samples; ++i) {
+        rampTowards(bus.duck, duckTarget, DUCK_RAMP_STEP);
+        mix[i] += gain * bus.duck * gateVoice->nextSample();
+    }
+
+    markFirstSample();
+    return samples;
+}
+
+void ToneDriverSDL2::applyLiveEvents()
+{
+    LiveEvent event;
+
+    while (liveEvents.pop(event))
+    {
+        if (!event.on)
+        {
+            for (LiveNote& live : liveNotes)
+            {
+                if (live.voice != nullptr && (event.key < 0 || live.key == event.key))
+                {
+                    live.releasing = true;
+                }
+            }
+            continue;
+        }
+
+        // Restart the note if it is sounding, otherwise take a free slot, or else one being released
+        LiveNote* slot = nullptr;
+        for (LiveNote& live : liveNotes)
+        {
+            if (live.voice != nullptr && live.key == event.key) { slot = &live; break; }
+        }
+        for (int pass = 0; pass < 2 && slot == nullptr; ++pass)
+        {
+            for (LiveNote& live : liveNotes)
+            {
+                if ((pass == 0) ? live.voice == nullptr : live.releasing) { slot = &live; break; }
+            }
+        }
+
+        if (slot == nullptr)
+        {
+            diagnostics.report(DiagnosticCode::VoicePoolExhausted, MAX_LIVE_NOTES, MAX_LIVE_NOTES);
+            continue;
+        }
+
+        if (slot->voice == nullptr && !acquireVoice(slot->voice))
+        {
+            continue;
+        }
+
+        slot->key = event.key;
+        slot->level = 1.0f;
+        slot->releasing = false;
+        slot->voice->start(event.frequency, SAMPLE_RATE);
+        applyWaveform(buses[int(AudioBus::Music)], *slot->voice);
+
+        // Key to first sample: this chunk is rendered now
+        Uint64 latency = SDL_GetPerformanceCounter() - event.ticks;
+        noteOnLatencyLastTicks.store(latency, std::memory_order_relaxed);
+        noteOnLatencyTotalTicks.store(noteOnLatencyTotalTicks.load(std::memory_order_relaxed) + latency, std::memory_order_relaxed);
+        if (latency > noteOnLatencyMaxTicks.load(std::memory_order_relaxed))
+        {
+            noteOnLatencyMaxTicks.store(latency, std::memory_order_relaxed);
+        }
+        noteOnLatencyCount.store(noteOnLatencyCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+}
+
+void ToneDriverSDL2::mixLiveNotes(Bus& bus, float* mix, int samples)
+{
+    const float gain = bus.gain.load(std::memory_order_relaxed) * bus.duck;
+
+    for (LiveNote& live : liveNotes)
+    {
+        if (live.voice == nullptr)
+        {
+            continue;
+        }
+
+        markFirstSample();
+        for (int i = 0; i < samples; ++i)
+        {
+            if (live.releasing)
+            {
+                live.level -= LIVE_RELEASE_STEP;
+                if (live.level <= 0.0f)
+                {
+                    releaseVoice(live.voice); // Faded out: free the slot
+                    break;
+                }
+            }
+
+            mix[i] += gain * live.level * live.voice->nextSample();
+        }
+    }
+}
+
+bool ToneDriverSDL2::nextStep(Bus& bus)
+{
+    releaseVoice(bus.voice); // Rests and pre-rendered samples need no voice
+    releaseVoice(bus.noise);
+
+    do
+    {
+        if (!bus.steps.pop(bus.step))
+        {
+            return false;
+        }
+    } while (bus.step.samples == 0);
+
+    bus.remaining = bus.step.samples;
+    bus.replaying = false;
+
+    if (bus.step.noise)
+    {
+        if (acquireVoice(bus.noise))
+        {
+            bus.noise->start(bus.step.noiseHit, bus.step.samples, SAMPLE_RATE);
+        }
+    }
+    else if (bus.step.pcm == nullptr && bus.step.frequency > 0.0f && acquireVoice(bus.voice))
+    {
+        bus.voice->start(bus.step.frequency, bus.step.samples, bus.step.automation, SAMPLE_RATE);
+        applyWaveform(bus, *bus.voice);
+    }
+
+    return true;
+}
+
+void ToneDriverSDL2::applyBusClear(Bus& bus)
+{
+    unsigned requests = bus.clearRequests.load(std::memory_order_acquire);
+    if (requests == bus.clearsApplied)
+    {
+        return;
+    }
+
+    // Count dropped steps as rendered so waitForBus() returns (a loop's pass already was)
+    Uint64 dropped = bus.replaying ? 0 : bus.remaining;
+    while (bus.steps.pop(bus.step))
+    {
+        dropped += bus.step.samples;
+    }
+
+    bus.remaining = 0;
+    bus.step.loopEnd = 0;
+    bus.replaying = false;
+    releaseVoice(bus.voice);
+    releaseVoice(bus.noise);
+    bus.clearsApplied = requests;
+    bus.loopReleasesApplied = bus.loopReleases.load(std::memory_order_acquire); // Releases don't outlive a clear
+    bus.samplesRendered.fetch_add(dropped, std::memory_order_release);
+}
+
+bool ToneDriverSDL2::isBusActive(int index)
+{
+    if (hasStepWork(buses[index]))
+    {
+        return true;
+    }
+
+    if (index == FOREGROUND_BUS)
+    {
+        return gateOpen;
+    }
+
+    if (index == int(AudioBus::Music))
+    {
+        for (const LiveNote& live : liveNotes)
+        {
+            if (live.voice != nullptr) return true;
+        }
+    }
+
+    return false;
+}
+
+bool ToneDriverSDL2::hasStepWork(const Bus& bus)
+{
+    return bus.remaining > 0 || bus.step.loopEnd > 0 || !bus.steps.empty();
+}
+
+bool ToneDriverSDL2::acquireVoice(Voice*& voice)
+{
+    voice = voicePool.acquire();
+
+    if (voice == nullptr)
+    {
+        diagnostics.report(DiagnosticCode::VoicePoolExhausted, int(VOICE_POOL_SIZE), int(VOICE_POOL_SIZE));
+        return false;
+    }
+
+    return true;
+}
+
+void ToneDriverSDL2::applyWaveform(const Bus& bus, Voice& voice)
+{
+    voice.setWaveform(Waveform(bus.waveform.load(std::memory_order_relaxed)), bus.pulseWidth.load(std::memory_order_relaxed));
+}
+
+bool ToneDriverSDL2::acquireVoice(NoiseVoice*& voice)
+{
+    voice = noisePool.acquire();
+
+    if (voice == nullptr)
+    {
+        diagnostics.report(DiagnosticCode::VoicePoolExhausted, int(NOISE_POOL_SIZE), int(NOISE_POOL_SIZE));
+        return false;
+    }
+
+    return true;
+}
+
+void ToneDriverSDL2::releaseVoice(Voice*& voice)
+{
+    voicePool.release(voice);
+    voice = nullptr;
+}
+
+void ToneDriverSDL2::releaseVoice(NoiseVoice*& voice)
+{
+    noisePool.release(voice);
+    voice = nullptr;
+}
+
+int ToneDriverSDL2::getSemitonesDiff(NoteName note1, int octave1, NoteName note2, int octave2)
+{
+    return (int(note2) + (12 * octave2)) - (int(note1) + (12 * octave1));
+}
+
+void ToneDriverSDL2::setNoteFrequency(float freq)
+{
+    currentFrequency = freq;
+}
+
+void ToneDriverSDL2::setNoteFrequency(NoteName note, int octave)
+{
+    // should isValidNote be happening in here rather than in playNote?
+    currentFrequency = getNoteFrequency(note, octave);
+}
+
+float ToneDriverSDL2::getNoteFrequency(NoteName note, int octave)
+{
+    return REF_FREQ * pow(2, getSemitonesDiff(REF_NOTE, REF_OCTAVE, note, octave) / 12.0);
+}
+
+void ToneDriverSDL2::setAmplitude(float amplitude)
+{
+    if (amplitude < 0.0f) amplitude = 0.0f;
+    if (amplitude > 1.0f) amplitude = 1.0f;
+    currentAmplitude = amplitude;
+}
+
+void ToneDriverSDL2::setWarmDevice(bool enabled)
+{
+    warmDevice = enabled;
+
+    // A warm device runs continuously and renders silence while the gate is closed
+    setDevicePaused(!(enabled || gateOpen || hasPendingWork()));
+}
+
+bool ToneDriverSDL2::isWarmDevice() const
+{
+    return warmDevice;
+}
+
+float ToneDriverSDL2::getOnsetLatencyMs() const
+{
+    if (!onsetMeasured)
+    {
+        return -1.0f;
+    }
+
+    return 1000.0f * onsetLatencyTicks.load(std::memory_order_relaxed) / SDL_GetPerformanceFrequency();
+}
+
+float ToneDriverSDL2::getBufferDurationMs() const
+{
+    return 1000.0f * bufferSamples / SAMPLE_RATE;
+}
+
+int ToneDriverSDL2::getOutputChannels() const
+{
+    return outputChannels;
+}
+
+bool ToneDriverSDL2::isValidNote(NoteName note, int octave)
+{
+    if (note < NoteName::C || note > NoteName::B) {
+        diagnostics.report(DiagnosticCode::InvalidNote, int(note), int(NoteName::B));
+        return false;
+    }
+    if (octave < 0 || octave > MAX_OCTAVE) {
+        diagnostics.report(DiagnosticCode::InvalidOctave, octave, MAX_OCTAVE);
+        return false;
+    }
+
+    return true;
+}
+
+ToneDriverDiagnostics& ToneDriverSDL2::getDiagnostics()
+{
+    return diagnostics;
+}
+
+ToneDriverSDL2::StartupTimings ToneDriverSDL2::getStartupTimings() const
+{
+    auto sinceConstruction = [this](Uint64 ticks) {
+        return (ticks == 0) ? -1.0f : float(1000.0 * double(ticks - constructTicks) / SDL_GetPerformanceFrequency());
+    };
+
+    StartupTimings timings;
+    timings.constructorMs = sinceConstruction(constructedTicks);
+    timings.deviceReadyMs = sinceConstruction(deviceReadyTicks);
+    timings.firstSampleMs = sinceConstruction(firstSampleTicks.load(std::memory_order_relaxed));
+    return timings;
+}
+
+ToneDriverSDL2::CallbackTimings ToneDriverSDL2::getCallbackTimings() const
+{
+    const double msPerTick = 1000.0 / SDL_GetPerformanceFrequency();
+    Uint64 callbacks = callbackCount.load(std::memory_order_acquire);
+    Uint64 intervals = callbackIntervals.load(std::memory_order_relaxed);
+
+    CallbackTimings timings;
+    timings.callbacks = callbacks;
+    timings.meanIntervalMs = (intervals > 0) ? float(msPerTick * callbackIntervalTicks.load(std::memory_order_relaxed) / intervals) : 0.0f;
+    timings.maxIntervalMs = float(msPerTick * maxCallbackIntervalTicks.load(std::memory_order_relaxed));
+    timings.maxLatenessMs = (intervals > 0 && timings.maxIntervalMs > getBufferDurationMs()) ? timings.maxIntervalMs - getBufferDurationMs() : 0.0f;
+    timings.meanRenderMs = (callbacks > 0) ? float(msPerTick * callbackRenderTicks.load(std::memory_order_relaxed) / callbacks) : 0.0f;
+    timings.maxRenderMs = float(msPerTick * maxCallbackRenderTicks.load(std::memory_order_relaxed));
+    return timings;
+}
+
+void ToneDriverSDL2::resetCallbackTimings()
+{
+    callbackTimingResets.fetch_add(1, std::memory_order_release); // Applied by the next callback
+}
+
+void ToneDriverSDL2::setAudioThreadOptions(const AudioThreadOptions& options)
+{
+    requestedThreadPriority.store(int(options.priority), std::memory_order_relaxed);
+    requestedCpuMask.store(options.cpuMask, std::memory_order_relaxed);
+    threadOptionsApplied.store(false, std::memory_order_relaxed);
+    threadOptionsVersion.fetch_add(1, std::memory_order_release); // Picked up by the next callback
+}
+
+AudioThreadStatus ToneDriverSDL2::getAudioThreadStatus() const
+{
+    AudioThreadStatus status;
+    status.applied = threadOptionsApplied.load(std::memory_order_acquire);
+    status.priority = AudioThreadPriority(achievedThreadPriority.load(std::memory_order_relaxed));
+    status.cpuMask = achievedCpuMask.load(std::memory_order_relaxed);
+    return status;
+}
+
+ToneDriverSDL2::~ToneDriverSDL2()
+{
+    if (initThread.joinable())
+    {
+        initThread.join(); // The device may still be opening
+    }
+
+    // Shut down the SDL audio subsystem
+    SDL_CloseAudio();
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+
+    diagnostics.flush(); // Errors logged since the last blocking call
 }
\ No newline at end of file
@@ -0,0 +1,360 @@
+/// @file ChannelRenderer.cpp
+/// @brief Implementation of the ChannelRenderer class.
+
+#include "tone-synth/ChannelRenderer.h"
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+static constexpr double PHASE_SCALE = 4294967296.0;   // 2^32: one cycle of the fixed-point phase
+static constexpr int REF_FREQ = 440;                  // A4
+static constexpr int REF_SEMITONE = (4 * 12) + int(NoteName::A);
+
+
+#if defined(__AVX2__) || defined(__SSE2__)
+/**
+ * @brief Transposes an 8x8 block of 16-bit samples in place.
+ *
+ * On entry rows[t] holds sample t of eight channels; on exit rows[c] holds eight samples of channel c.
+ */
+static inline void transpose8x8(__m128i rows[8])
+{
+    __m128i a0 = _mm_unpacklo_epi16(rows[0], rows[1]);
+    __m128i a1 = _mm_unpackhi_epi16(rows[0], rows[1]);
+    __m128i a2 = _mm_unpacklo_epi16(rows[2], rows[3]);
+    __m128i a3 = _mm_unpackhi_epi16(rows[2], rows[3]);
+    __m128i a4 = _mm_unpacklo_epi16(rows[4], rows[5]);
+    __m128i a5 = _mm_unpackhi_epi16(rows[4], rows[5]);
+    __m128i a6 = _mm_unpacklo_epi16(rows[6], rows[7]);
+    __m128i a7 = _mm_unpackhi_epi16(rows[6], rows[7]);
+
+    __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+    __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+    __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+    __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+    __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+    __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+    __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+    __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+    rows[0] = _mm_unpacklo_epi64(b0, b4);
+    rows[1] = _mm_unpackhi_epi64(b0, b4);
+    rows[2] = _mm_unpacklo_epi64(b1, b5);
+    rows[3] = _mm_unpackhi_epi64(b1, b5);
+    rows[4] = _mm_unpacklo_epi64(b2, b6);
+    rows[5] = _mm_unpackhi_epi64(b2, b6);
+    rows[6] = _mm_unpacklo_epi64(b3, b7);
+    rows[7] = _mm_unpackhi_epi64(b3, b7);
+}
+#endif
+
+
+ChannelRenderer::ChannelRenderer(int channelCount, int sampleRate)
+    : channelCount_(channelCount > 0 ? channelCount : 0),
+      sampleRate_(sampleRate > 0 ? sampleRate : DEFAULT_SAMPLE_RATE),
+      phase_(channelCount_, 0),
+      increment_(channelCount_, 0),
+      amplitude_(channelCount_, 0)
+{
+}
+
+ChannelRenderer::~ChannelRenderer()
+{
+    stopWorkers();
+}
+
+void ChannelRenderer::setFrequency(int channel, float freq)
+{
+    if (channel < 0 || channel >= channelCount_) return;
+    if (freq < 0.0f) freq = 0.0f;
+
+    increment_[channel] = uint32_t(std::llround((double(freq) / sampleRate_) * PHASE_SCALE) & 0xFFFFFFFFull);
+}
+
+void ChannelRenderer::setNote(int channel, NoteName note, int octave)
+{
+    int semitones = ((octave * 12) + int(note)) - REF_SEMITONE;
+    setFrequency(channel, float(REF_FREQ * std::pow(2.0, semitones / 12.0)));
+}
+
+void ChannelRenderer::setAmplitude(int channel, float amplitude)
+{
+    if (channel < 0 || channel >= channelCount_) return;
+    if (amplitude < 0.0f) amplitude = 0.0f;
+    if (amplitude > 1.0f) amplitude = 1.0f;
+
+    amplitude_[channel] = int32_t(32767 * amplitude);
+}
+
+void ChannelRenderer::stop(int channel)
+{
+    if (channel < 0 || channel >= channelCount_) return;
+
+    amplitude_[channel] = 0;
+    increment_[channel] = 0;
+    phase_[channel] = 0;
+}
+
+void ChannelRenderer::setThreadCount(int threadCount)
+{
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount == threadCount_) return;
+
+    stopWorkers();
+
+    std::lock_guard<std::mutex> lock(jobMutex_);
+    threadCount_ = threadCount;
+    stopping_ = false;
+
+    for (int worker = 1; worker < threadCount_; ++worker)
+    {
+        workers_.emplace_back(&ChannelRenderer::workerLoop, this, worker);
+    }
+}
+
+void ChannelRenderer::render(int16_t* const outputs[], int samples)
+{
+    if (threadCount_ == 1)
+    {
+        renderRange(outputs, samples, 0, channelCount_);
+        return;
+    }
+
+    // Post the job to the workers
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        jobOutputs_ = outputs;
+        jobSamples_ = samples;
+        jobPending_ = threadCount_ - 1;
+        ++jobGeneration_;
+    }
+    jobReady_.notify_all();
+
+    // The calling thread renders the first partition
+    int first, end;
+    getPartition(0, first, end);
+    renderRange(outputs, samples, first, end);
+
+    std::unique_lock<std::mutex> lock(jobMutex_);
+    jobDone_.wait(lock, [this] { return jobPending_ == 0; });
+}
+
+void ChannelRenderer::renderRange(int16_t* const outputs[], int samples, int firstChannel, int endChannel)
+{
+    if (firstChannel < 0) firstChannel = 0;
+    if (endChannel > channelCount_) endChannel = channelCount_;
+
+    int channel = firstChannel;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    // Eight channels at a time, one per lane, straight from the state arrays
+    for (; channel + GROUP_CHANNELS <= endChannel; channel += GROUP_CHANNELS)
+    {
+        renderGroup(outputs, samples, channel);
+    }
+#endif
+
+    for (; channel < endChannel; ++channel)
+    {
+        renderChannel(channel, outputs[channel], samples);
+    }
+}
+
+void ChannelRenderer::renderGroup(int16_t* const outputs[], int samples, int firstChannel)
+{
+    int i = 0;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+    // Each step advances eight channels by one sample; eight steps are transposed into eight samples per channel
+#if defined(__AVX2__)
+    __m256i phases = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&phase_[firstChannel]));
+    const __m256i increments = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&increment_[firstChannel]));
+    const __m256i amps = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&amplitude_[firstChannel]));
+#else
+    __m128i phasesLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&phase_[firstChannel]));
+    __m128i phasesHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&phase_[firstChannel + 4]));
+    const __m128i incrementsLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&increment_[firstChannel]));
+    const __m128i incrementsHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&increment_[firstChannel + 4]));
+    const __m128i ampsLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&amplitude_[firstChannel]));
+    const __m128i ampsHi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&amplitude_[firstChannel + 4]));
+#endif
+
+    for (; i + GROUP_CHANNELS <= samples; i += GROUP_CHANNELS)
+    {
+        __m128i rows[GROUP_CHANNELS];
+
+        for (int t = 0; t < GROUP_CHANNELS; ++t)
+        {
+#if defined(__AVX2__)
+            __m256i mask = _mm256_srai_epi32(phases, 31);
+            __m256i wave = _mm256_sub_epi32(_mm256_xor_si256(amps, mask), mask);
+            rows[t] = _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packs_epi32(wave, wave), 0x08));
+            phases = _mm256_add_epi32(phases, increments);
+#else
+            __m128i maskLo = _mm_srai_epi32(phasesLo, 31);
+            __m128i maskHi = _mm_srai_epi32(phasesHi, 31);
+            rows[t] = _mm_packs_epi32(_mm_sub_epi32(_mm_xor_si128(ampsLo, maskLo), maskLo),
+                                      _mm_sub_epi32(_mm_xor_si128(ampsHi, maskHi), maskHi));
+            phasesLo = _mm_add_epi32(phasesLo, incrementsLo);
+            phasesHi = _mm_add_epi32(phasesHi, incrementsHi);
+#endif
+        }
+
+        transpose8x8(rows);
+
+        for (int c = 0; c < GROUP_CHANNELS; ++c)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(outputs[firstChannel + c] + i), rows[c]);
+        }
+    }
+
+#if defined(__AVX2__)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&phase_[firstChannel]), phases);
+#else
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&phase_[firstChannel]), phasesLo);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&phase_[firstChannel + 4]), phasesHi);
+#endif
+#endif
+
+    // Samples left over after the last block of eight
+    for (int c = 0; c < GROUP_CHANNELS && i < samples; ++c)
+    {
+        renderChannel(firstChannel + c, outputs[firstChannel + c] + i, samples - i);
+    }
+}
+
+void ChannelRenderer::renderChannel(int channel, int16_t* output, int samples)
+{
+    uint32_t phase = phase_[channel];
+    const uint32_t increment = increment_[channel];
+    const int32_t amplitude = amplitude_[channel];
+    int i = 0;
+
+    // Square wave: +amplitude for the first half of each cycle, -amplitude for the second.
+    // The sign bit of the phase selects the half, so out = (amplitude ^ mask) - mask.
+#if defined(__AVX2__)
+    const __m256i amp = _mm256_set1_epi32(amplitude);
+    const __m256i step = _mm256_set1_epi32(int32_t(increment * 8u));
+    __m256i lanes = _mm256_mullo_epi32(_mm256_set1_epi32(int32_t(increment)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i phases = _mm256_add_epi32(_mm256_set1_epi32(int32_t(phase)), lanes);
+
+    for (; i + 8 <= samples; i += 8)
+    {
+        __m256i mask = _mm256_srai_epi32(phases, 31);
+        __m256i wave = _mm256_sub_epi32(_mm256_xor_si256(amp, mask), mask);
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(wave, wave), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm256_castsi256_si128(packed));
+        phases = _mm256_add_epi32(phases, step);
+    }
+    phase += increment * uint32_t(i);
+#elif defined(__SSE2__)
+    const __m128i amp = _mm_set1_epi32(amplitude);
+    const __m128i step = _mm_set1_epi32(int32_t(increment * 4u));
+    __m128i phases = _mm_setr_epi32(int32_t(phase), int32_t(phase + increment), int32_t(phase + (2u * increment)), int32_t(phase + (3u * increment)));
+
+    for (; i + 4 <= samples; i += 4)
+    {
+        __m128i mask = _mm_srai_epi32(phases, 31);
+        __m128i wave = _mm_sub_epi32(_mm_xor_si128(amp, mask), mask);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(wave, wave));
+        phases = _mm_add_epi32(phases, step);
+    }
+    phase += increment * uint32_t(i);
+#endif
+
+    // Scalar tail (or the whole buffer without SIMD)
+    for (; i < samples; ++i)
+    {
+        output[i] = int16_t((phase & 0x80000000u) ? -amplitude : amplitude);
+        phase += increment;
+    }
+
+    phase_[channel] = phase;
+}
+
+void ChannelRenderer::workerLoop(int worker)
+{
+    unsigned seenGeneration;
+    {
+        // Jobs posted before this worker started are not its to render
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        seenGeneration = jobGeneration_;
+    }
+
+    while (true)
+    {
+        int16_t* const* outputs;
+        int samples;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            jobReady_.wait(lock, [&] { return stopping_ || jobGeneration_ != seenGeneration; });
+            if (stopping_) return;
+
+            seenGeneration = jobGeneration_;
+            outputs = jobOutputs_;
+            samples = jobSamples_;
+        }
+
+        int first, end;
+        getPartition(worker, first, end);
+        renderRange(outputs, samples, first, end);
+
+        {
+            std::lock_guard<std::mutex> lock(jobMutex_);
+            --jobPending_;
+        }
+        jobDone_.notify_one();
+    }
+}
+
+void ChannelRenderer::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        stopping_ = true;
+        jobOutputs_ = nullptr; // The last job's buffers may be freed once render() returns
+        jobSamples_ = 0;
+    }
+    jobReady_.notify_all();
+
+    for (std::thread& worker : workers_)
+    {
+        worker.join();
+    }
+    workers_.clear();
+    threadCount_ = 1;
+}
+
+void ChannelRenderer::getPartition(int worker, int& first, int& end) const
+{
+    first = int((int64_t(channelCount_) * worker) / threadCount_);
+    end = int((int64_t(channelCount_) * (worker + 1)) / threadCount_);
+}
+
+int ChannelRenderer::getChannelCount() const
+{
+    return channelCount_;
+}
+
+int ChannelRenderer::getSampleRate() const
+{
+    return sampleRate_;
+}
+
+int ChannelRenderer::getThreadCount() const
+{
+    return threadCount_;
+}
+
+const char* ChannelRenderer::getInstructionSet()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,94 @@
+/// @file NoiseVoice.cpp
+/// @brief Implementation of the NoiseVoice class.
+
+#include "tone-synth/NoiseVoice.h"
+
+static constexpr double CLOCK_SCALE = 4294967296.0;  // 2^32: one register step of the fixed-point clock phase
+static constexpr int LEVEL_SHIFT = 16;               // Fractional bits of the envelope level
+static constexpr int EXPONENTIAL_TIME_CONSTANTS = 5; // Time constants per hit (e^-5 is about -43 dB)
+
+
+void NoiseVoice::start(const NoiseHit& hit, uint32_t samples, int sampleRate)
+{
+    if (sampleRate <= 0) sampleRate = 44100;
+    float level = (hit.level < 0.0f) ? 0.0f : (hit.level > 1.0f) ? 1.0f : hit.level;
+    double stepsPerSample = (hit.clockHz > 0.0f) ? double(hit.clockHz) / sampleRate : 0.0;
+    if (stepsPerSample > MAX_STEPS_PER_SAMPLE) stepsPerSample = MAX_STEPS_PER_SAMPLE;
+
+    active_ = samples > 0;
+    register_ = REGISTER_SEED;
+    tap_ = (hit.mode == NoiseMode::Short) ? 6 : 1;
+    phase_ = 0;
+    increment_ = uint64_t(stepsPerSample * CLOCK_SCALE);
+    decay_ = hit.decay;
+    level_ = uint32_t(level * 32767.0f) << LEVEL_SHIFT;
+    linearStep_ = (samples > 0) ? level_ / samples : 0;
+    remaining_ = samples;
+
+    // A shift of n loses 1/2^n of the level per sample: a time constant of about 2^n samples
+    uint32_t timeConstant = samples / EXPONENTIAL_TIME_CONSTANTS;
+    decayShift_ = 0;
+    while (decayShift_ < 30 && (1u << (decayShift_ + 1)) <= timeConstant)
+    {
+        ++decayShift_;
+    }
+}
+
+void NoiseVoice::stop()
+{
+    active_ = false;
+}
+
+int16_t NoiseVoice::nextSample()
+{
+    if (!active_)
+    {
+        return 0;
+    }
+
+    // Clock the register once for every whole step the phase has moved on
+    phase_ += increment_;
+    for (uint32_t steps = uint32_t(phase_ >> 32); steps > 0; --steps)
+    {
+        clock();
+    }
+    phase_ &= 0xFFFFFFFFull;
+
+    int32_t amplitude = int32_t(level_ >> LEVEL_SHIFT);
+    int16_t sample = int16_t((register_ & 1) ? -amplitude : amplitude);
+
+    switch (decay_)
+    {
+        case NoiseDecay::Linear:
+            level_ = (level_ > linearStep_) ? level_ - linearStep_ : 0;
+            break;
+        case NoiseDecay::Exponential:
+            level_ -= level_ >> decayShift_;
+            break;
+        case NoiseDecay::None:
+            break;
+    }
+
+    if (--remaining_ == 0)
+    {
+        active_ = false;
+    }
+
+    return sample;
+}
+
+bool NoiseVoice::isActive() const
+{
+    return active_;
+}
+
+uint16_t NoiseVoice::getRegister() const
+{
+    return register_;
+}
+
+void NoiseVoice::clock()
+{
+    uint16_t feedback = (register_ ^ (register_ >> tap_)) & 1;
+    register_ = uint16_t((register_ >> 1) | (feedback << 14));
+}
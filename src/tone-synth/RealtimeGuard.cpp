@@ -0,0 +1,183 @@
+/// @file RealtimeGuard.cpp
+/// @brief Implementation of the RealtimeGuard class and, in checked builds, the allocation and lock hooks.
+
+#include "tone-synth/RealtimeGuard.h"
+
+#ifdef TONE_DRIVER_RT_CHECKS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <pthread.h>
+
+static constexpr size_t VIOLATION_COUNT = size_t(RealtimeViolation::Count);
+
+static thread_local int guardDepth = 0;                         ///< Guards alive on this thread.
+static std::atomic<uint64_t> violationCounts[VIOLATION_COUNT];  ///< Violations of each type.
+
+/**
+ * @brief Counts a violation if the calling thread is inside a guard.
+ *
+ * @param violation The type of violation.
+ */
+static void recordViolation(RealtimeViolation violation)
+{
+    if (guardDepth > 0)
+    {
+        violationCounts[size_t(violation)].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+// ---------------------------------- L I N K E R   H O O K S ----------------------------------
+// Built with -Wl,--wrap=<symbol>, so every call to <symbol> in the program lands here first.
+#ifdef TONE_DRIVER_RT_WRAP
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+void __real_free(void* pointer);
+int __real_pthread_mutex_lock(pthread_mutex_t* mutex);
+
+void* __wrap_malloc(size_t size)
+{
+    recordViolation(RealtimeViolation::Allocation);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    recordViolation(RealtimeViolation::Allocation);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size)
+{
+    recordViolation(RealtimeViolation::Allocation);
+    return __real_realloc(pointer, size);
+}
+
+void __wrap_free(void* pointer)
+{
+    if (pointer != nullptr)
+    {
+        recordViolation(RealtimeViolation::Deallocation);
+    }
+    __real_free(pointer);
+}
+
+int __wrap_pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+    recordViolation(RealtimeViolation::Lock);
+    return __real_pthread_mutex_lock(mutex);
+}
+}
+
+#endif // TONE_DRIVER_RT_WRAP
+
+
+// ----------------------------- O P E R A T O R   N E W / D E L E T E -----------------------------
+// Replaced so that allocations made inside the C++ runtime go through malloc and free above.
+// Without the linker hooks they are the only allocations that are counted.
+
+void* operator new(size_t size)
+{
+#ifndef TONE_DRIVER_RT_WRAP
+    recordViolation(RealtimeViolation::Allocation);
+#endif
+    void* pointer = std::malloc(size ? size : 1);
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+#ifndef TONE_DRIVER_RT_WRAP
+    if (pointer != nullptr)
+    {
+        recordViolation(RealtimeViolation::Deallocation);
+    }
+#endif
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+
+// ------------------------------------- R E A L T I M E G U A R D -------------------------------------
+
+RealtimeGuard::RealtimeGuard()
+{
+    ++guardDepth;
+}
+
+RealtimeGuard::~RealtimeGuard()
+{
+    --guardDepth;
+}
+
+bool RealtimeGuard::isEnabled()
+{
+    return true;
+}
+
+bool RealtimeGuard::isActive()
+{
+    return guardDepth > 0;
+}
+
+uint64_t RealtimeGuard::getViolationCount(RealtimeViolation violation)
+{
+    size_t index = size_t(violation);
+    return (index < VIOLATION_COUNT) ? violationCounts[index].load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t RealtimeGuard::getTotalViolationCount()
+{
+    uint64_t total = 0;
+    for (size_t i = 0; i < VIOLATION_COUNT; ++i)
+    {
+        total += violationCounts[i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void RealtimeGuard::resetViolations()
+{
+    for (size_t i = 0; i < VIOLATION_COUNT; ++i)
+    {
+        violationCounts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+#else // TONE_DRIVER_RT_CHECKS
+
+bool RealtimeGuard::isEnabled() { return false; }
+bool RealtimeGuard::isActive() { return false; }
+uint64_t RealtimeGuard::getViolationCount(RealtimeViolation) { return 0; }
+uint64_t RealtimeGuard::getTotalViolationCount() { return 0; }
+void RealtimeGuard::resetViolations() {}
+
+#endif // TONE_DRIVER_RT_CHECKS
@@ -0,0 +1,137 @@
+/// @file SegmentedRenderer.cpp
+/// @brief Implementation of the SegmentedRenderer class.
+
+#include "tone-synth/SegmentedRenderer.h"
+#include <algorithm>
+#include <thread>
+
+
+/**
+ * @brief Renders samples of one note from a given phase.
+ *
+ * @return The phase after the last sample.
+ */
+static uint32_t renderSquare(uint32_t phase, uint32_t increment, int amplitude, bool silent, size_t count, int16_t* out)
+{
+    if (silent)
+    {
+        std::fill(out, out + count, int16_t(0));
+        return phase;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = int16_t((phase & 0x80000000u) ? -amplitude : amplitude);
+        phase += increment;
+    }
+    return phase;
+}
+
+
+SegmentedRenderer::SegmentedRenderer(const std::vector<SongNote>& notes, PhaseMode mode, int sampleRate, int amplitude)
+    : amplitude_(amplitude), offsets_(notes.size() + 1, 0), increments_(notes.size(), 0), startPhases_(notes.size(), 0)
+{
+    uint32_t phase = 0;
+
+    for (size_t i = 0; i < notes.size(); ++i)
+    {
+        const SongNote& note = notes[i];
+        const size_t length = (note.durationMs > 0) ? staticSongNoteSamples(note, sampleRate) : 0;
+        const bool valid = !note.isRest && note.note >= NoteName::C && note.note <= NoteName::B &&
+                           note.octave >= 0 && note.octave <= STATIC_SONG_MAX_OCTAVE;
+
+        offsets_[i + 1] = offsets_[i] + length;
+        increments_[i] = valid ? staticSongPhaseIncrement(note, sampleRate) : 0;
+
+        // Wrapping arithmetic gives the same phase as adding the increment once per sample
+        startPhases_[i] = (mode == PhaseMode::Continuous) ? phase : 0;
+        phase = startPhases_[i] + increments_[i] * uint32_t(length);
+    }
+}
+
+void SegmentedRenderer::renderSerial(int16_t* out) const
+{
+    for (size_t i = 0; i < increments_.size(); ++i)
+    {
+        const size_t length = offsets_[i + 1] - offsets_[i];
+        renderSquare(startPhases_[i], increments_[i], amplitude_, increments_[i] == 0, length, out + offsets_[i]);
+    }
+}
+
+void SegmentedRenderer::render(int16_t* out, unsigned threadCount) const
+{
+    const size_t samples = getSampleCount();
+
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // No point splitting below a few thousand samples per thread
+    threadCount = unsigned(std::min<size_t>(threadCount, std::max<size_t>(1, samples / 4096)));
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+
+    for (unsigned segment = 0; segment < threadCount; ++segment)
+    {
+        // Segment boundaries on cache lines so neighbouring threads never share one
+        size_t first = (samples * segment / threadCount) / SEGMENT_ALIGNMENT * SEGMENT_ALIGNMENT;
+        size_t end = (segment + 1 == threadCount) ? samples : (samples * (segment + 1) / threadCount) / SEGMENT_ALIGNMENT * SEGMENT_ALIGNMENT;
+
+        if (segment + 1 == threadCount)
+        {
+            renderRange(first, end - first, out + first); // The calling thread renders the last segment
+        }
+        else
+        {
+            workers.emplace_back(&SegmentedRenderer::renderRange, this, first, end - first, out + first);
+        }
+    }
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void SegmentedRenderer::renderRange(size_t first, size_t count, int16_t* out) const
+{
+    const size_t end = std::min(first + count, getSampleCount());
+    if (first >= end)
+    {
+        return;
+    }
+
+    size_t sample = first;
+    for (size_t note = findNote(first); sample < end; ++note)
+    {
+        const size_t noteEnd = std::min(offsets_[note + 1], end);
+        const uint32_t phase = startPhases_[note] + increments_[note] * uint32_t(sample - offsets_[note]);
+
+        renderSquare(phase, increments_[note], amplitude_, increments_[note] == 0, noteEnd - sample, out + (sample - first));
+        sample = noteEnd;
+    }
+}
+
+uint32_t SegmentedRenderer::getPhaseAt(size_t sample) const
+{
+    if (sample >= getSampleCount())
+    {
+        return increments_.empty() ? 0 : startPhases_.back() + increments_.back() * uint32_t(offsets_.back() - offsets_[offsets_.size() - 2]);
+    }
+
+    size_t note = findNote(sample);
+    return startPhases_[note] + increments_[note] * uint32_t(sample - offsets_[note]);
+}
+
+size_t SegmentedRenderer::getSampleCount() const
+{
+    return offsets_.back();
+}
+
+size_t SegmentedRenderer::findNote(size_t sample) const
+{
+    // The last note whose first sample is at or before this one (skips zero-length notes)
+    return size_t(std::upper_bound(offsets_.begin(), offsets_.end(), sample) - offsets_.begin()) - 1;
+}
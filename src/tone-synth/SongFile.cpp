@@ -0,0 +1,127 @@
+/// @file SongFile.cpp
+/// @brief Implementation of the song file reader and runtime song renderer.
+
+#include "tone-synth/SongFile.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+/// @brief Semitone of each note letter from A to G above C.
+static const int LETTER_SEMITONES[7] = {9, 11, 0, 2, 4, 5, 7};
+
+
+bool parseSongNote(const char* text, SongNote& note)
+{
+    while (std::isspace((unsigned char)*text)) ++text;
+
+    if (*text == 'R' || *text == 'r')
+    {
+        note = SongNote::rest(0);
+        ++text;
+    }
+    else
+    {
+        char letter = char(std::toupper((unsigned char)*text));
+        if (letter < 'A' || letter > 'G')
+        {
+            return false;
+        }
+
+        int semitone = LETTER_SEMITONES[letter - 'A'];
+        ++text;
+
+        if (*text == '#') { ++semitone; ++text; }
+        else if (*text == 'b') { --semitone; ++text; }
+
+        if (!std::isdigit((unsigned char)*text))
+        {
+            return false;
+        }
+
+        int octave = *text++ - '0';
+
+        // Cb and B# cross into the neighbouring octave
+        if (semitone < 0) { semitone += 12; --octave; }
+        if (semitone > 11) { semitone -= 12; ++octave; }
+
+        note = SongNote{NoteName(semitone), octave, 0};
+    }
+
+    char* end = nullptr;
+    long durationMs = std::strtol(text, &end, 10);
+    if (end == text || durationMs <= 0 || durationMs > 60000)
+    {
+        return false;
+    }
+
+    while (std::isspace((unsigned char)*end)) ++end;
+    if (*end != '\0' && *end != '#')
+    {
+        return false; // Trailing junk (a comment is allowed)
+    }
+
+    note.durationMs = int(durationMs);
+    return note.isRest || (note.octave >= 0 && note.octave <= STATIC_SONG_MAX_OCTAVE);
+}
+
+int parseSong(std::istream& in, std::vector<SongNote>& notes)
+{
+    notes.clear();
+
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(in, line))
+    {
+        ++lineNumber;
+
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+        {
+            continue;
+        }
+
+        if (!line.empty() && line.back() == '\r') line.pop_back(); // Files saved on Windows
+
+        SongNote note = SongNote::rest(0);
+        if (!parseSongNote(line.c_str(), note))
+        {
+            return lineNumber;
+        }
+
+        notes.push_back(note);
+    }
+
+    return 0;
+}
+
+bool isSameSongNote(const SongNote& a, const SongNote& b)
+{
+    if (a.durationMs != b.durationMs || a.isRest != b.isRest)
+    {
+        return false;
+    }
+
+    return a.isRest || (a.note == b.note && a.octave == b.octave);
+}
+
+void renderSongNote(const SongNote& note, int sampleRate, int amplitude, int16_t* out)
+{
+    const size_t length = staticSongNoteSamples(note, sampleRate);
+
+    if (note.isRest)
+    {
+        std::memset(out, 0, length * sizeof(int16_t));
+        return;
+    }
+
+    // Square wave from a fixed-point phase accumulator, restarted for each note
+    const uint32_t increment = staticSongPhaseIncrement(note, sampleRate);
+    uint32_t phase = 0;
+    for (size_t s = 0; s < length; ++s)
+    {
+        out[s] = int16_t((phase & 0x80000000u) ? -amplitude : amplitude);
+        phase += increment;
+    }
+}
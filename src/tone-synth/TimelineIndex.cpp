@@ -0,0 +1,146 @@
+/// @file TimelineIndex.cpp
+/// @brief Implementation of the TimelineIndex class.
+
+#include "tone-synth/TimelineIndex.h"
+#include <algorithm>
+
+
+TimelineIndex::TimelineIndex(const std::vector<SongNote>& notes, PhaseMode mode, int sampleRate, size_t checkpointInterval)
+    : mode_(mode), sampleRate_(sampleRate > 0 ? sampleRate : DEFAULT_SAMPLE_RATE),
+      checkpointInterval_(checkpointInterval > 0 ? checkpointInterval : DEFAULT_CHECKPOINT_INTERVAL),
+      offsets_(notes.size() + 1, 0), increments_(notes.size(), 0)
+{
+    checkpoints_.reserve((notes.size() / checkpointInterval_) + 1);
+    uint32_t phase = 0;
+
+    for (size_t i = 0; i < notes.size(); ++i)
+    {
+        const SongNote& note = notes[i];
+        const size_t length = (note.durationMs > 0) ? staticSongNoteSamples(note, sampleRate_) : 0;
+        const bool valid = !note.isRest && note.note >= NoteName::C && note.note <= NoteName::B &&
+                           note.octave >= 0 && note.octave <= STATIC_SONG_MAX_OCTAVE;
+
+        if (i % checkpointInterval_ == 0)
+        {
+            checkpoints_.push_back(phase);
+        }
+
+        offsets_[i + 1] = offsets_[i] + length;
+        increments_[i] = valid ? staticSongPhaseIncrement(note, sampleRate_) : 0;
+        phase += increments_[i] * uint32_t(length); // Wrapping arithmetic, as if added once per sample
+    }
+}
+
+TimelinePosition TimelineIndex::seek(size_t sample) const
+{
+    TimelinePosition position;
+
+    if (sample >= getSampleCount())
+    {
+        // The end of the song: render() has nothing left to play
+        position.sample = getSampleCount();
+        position.event = increments_.size();
+        return position;
+    }
+
+    position.sample = sample;
+    position.event = findEvent(sample);
+    position.phase = getStartPhase(position.event) + increments_[position.event] * uint32_t(sample - offsets_[position.event]);
+    return position;
+}
+
+TimelinePosition TimelineIndex::seekMs(long timeMs) const
+{
+    return seek((timeMs > 0) ? size_t((uint64_t(timeMs) * sampleRate_) / 1000) : 0);
+}
+
+size_t TimelineIndex::render(TimelinePosition& position, int16_t* out, size_t count, int amplitude) const
+{
+    size_t rendered = 0;
+
+    while (rendered < count && position.event < increments_.size())
+    {
+        const size_t noteEnd = offsets_[position.event + 1];
+        const size_t length = std::min(noteEnd - position.sample, count - rendered);
+        const uint32_t increment = increments_[position.event];
+
+        if (increment == 0)
+        {
+            std::fill(out + rendered, out + rendered + length, int16_t(0));
+        }
+        else
+        {
+            uint32_t phase = position.phase;
+            for (size_t i = 0; i < length; ++i)
+            {
+                out[rendered + i] = int16_t((phase & 0x80000000u) ? -amplitude : amplitude);
+                phase += increment;
+            }
+        }
+
+        rendered += length;
+        position.sample += length;
+        position.phase += increment * uint32_t(length);
+
+        if (position.sample == noteEnd)
+        {
+            // On to the next note (skipping any of zero length)
+            do
+            {
+                ++position.event;
+            } while (position.event < increments_.size() && offsets_[position.event + 1] == position.sample);
+
+            if (mode_ == PhaseMode::ResetPerNote)
+            {
+                position.phase = 0;
+            }
+        }
+    }
+
+    return rendered;
+}
+
+size_t TimelineIndex::getSampleCount() const
+{
+    return offsets_.back();
+}
+
+size_t TimelineIndex::getEventCount() const
+{
+    return increments_.size();
+}
+
+size_t TimelineIndex::getCheckpointInterval() const
+{
+    return checkpointInterval_;
+}
+
+size_t TimelineIndex::getMemoryBytes() const
+{
+    return (offsets_.capacity() * sizeof(size_t)) + (increments_.capacity() * sizeof(uint32_t)) + (checkpoints_.capacity() * sizeof(uint32_t));
+}
+
+size_t TimelineIndex::findEvent(size_t sample) const
+{
+    // The last note whose first sample is at or before this one (skips zero-length notes)
+    return size_t(std::upper_bound(offsets_.begin(), offsets_.end(), sample) - offsets_.begin()) - 1;
+}
+
+uint32_t TimelineIndex::getStartPhase(size_t event) const
+{
+    if (mode_ == PhaseMode::ResetPerNote)
+    {
+        return 0;
+    }
+
+    // Carry the checkpoint's phase over the notes between it and this one
+    size_t first = (event / checkpointInterval_) * checkpointInterval_;
+    uint32_t phase = checkpoints_[event / checkpointInterval_];
+
+    for (size_t i = first; i < event; ++i)
+    {
+        phase += increments_[i] * uint32_t(offsets_[i + 1] - offsets_[i]);
+    }
+
+    return phase;
+}
@@ -0,0 +1,195 @@
+/// @file Voice.cpp
+/// @brief Implementation of the Voice class.
+
+#include "tone-synth/Voice.h"
+#include <cmath>
+
+static constexpr double TWO_PI = 6.283185307179586;
+static constexpr double PHASE_SCALE = 18446744073709551616.0;   // 2^64: one cycle of the fixed-point phase
+
+
+/**
+ * @brief Converts cycles per sample to a fixed-point phase increment.
+ *
+ * Only the fractional part matters: a whole number of cycles per sample leaves the phase unchanged.
+ */
+static uint64_t toPhaseIncrement(double cyclesPerSample)
+{
+    double fraction = cyclesPerSample - std::floor(cyclesPerSample);
+    double scaled = fraction * PHASE_SCALE;
+
+    return (scaled >= PHASE_SCALE) ? 0 : uint64_t(scaled); // A fraction just under 1 can round up to a whole cycle
+}
+
+
+void Voice::start(float frequency, int sampleRate)
+{
+    start(frequency, 0, ToneAutomation(), sampleRate);
+    automated_ = false;
+}
+
+void Voice::start(float frequency, uint32_t samples, const ToneAutomation& automation, int sampleRate)
+{
+    active_ = true;
+    automated_ = true;
+    phase_ = 0;
+    frequency_ = frequency;
+    sampleRate_ = (sampleRate > 0) ? sampleRate : 44100;
+    elapsed_ = 0;
+    length_ = samples;
+    automation_ = automation;
+    vibratoIncrement_ = toPhaseIncrement(double(automation.vibratoRateHz) / sampleRate_);
+    controlCountdown_ = 0;
+    updateControl();
+}
+
+void Voice::setFrequency(float frequency)
+{
+    frequency_ = frequency;
+    if (!automated_)
+    {
+        currentFrequency_ = frequency;
+        increment_ = toPhaseIncrement(double(frequency) / sampleRate_);
+        selectTable();
+    }
+}
+
+void Voice::setWaveform(Waveform waveform, float pulseWidth)
+{
+    if (pulseWidth < MIN_PULSE_WIDTH) pulseWidth = MIN_PULSE_WIDTH;
+    if (pulseWidth > 1.0f - MIN_PULSE_WIDTH) pulseWidth = 1.0f - MIN_PULSE_WIDTH;
+
+    waveform_ = waveform;
+
+    // Pulse = saw(p) - saw(p + width), shifted so it goes high at the start of the cycle like the square
+    pulseWidth_ = uint64_t(double(pulseWidth) * PHASE_SCALE);
+    pulseOffset_ = uint64_t((0.5 - double(pulseWidth)) * PHASE_SCALE);
+    pulseDc_ = (2.0f * pulseWidth) - 1.0f;
+    selectTable();
+}
+
+Waveform Voice::getWaveform() const
+{
+    return waveform_;
+}
+
+void Voice::stop()
+{
+    active_ = false;
+}
+
+float Voice::nextSample()
+{
+    if (!active_)
+    {
+        return 0.0f;
+    }
+
+    float amplitude = 1.0f;
+
+    if (automated_)
+    {
+        if (controlCountdown_-- == 0)
+        {
+            updateControl();
+        }
+
+        // Amplitude ramps are evaluated every sample to avoid zipper noise
+        float progress = (length_ > 0) ? float(elapsed_) / float(length_) : 0.0f;
+        amplitude = automation_.startAmplitude + ((automation_.endAmplitude - automation_.startAmplitude) * progress);
+    }
+
+    float sample;
+    switch (waveform_)
+    {
+        case Waveform::Buzzer:
+            sample = (phase_ >> 63) ? -amplitude : amplitude;
+            break;
+        case Waveform::Pulse:
+        {
+            const uint64_t phase = phase_ + pulseOffset_;
+            sample = amplitude * (WavetableBank::lookup(table_, phase) - WavetableBank::lookup(table_, phase + pulseWidth_) + pulseDc_);
+            break;
+        }
+        default:
+            sample = amplitude * WavetableBank::lookup(table_, phase_);
+            break;
+    }
+
+    phase_ += increment_; // Wraps exactly at one cycle
+    ++elapsed_;
+
+    return sample;
+}
+
+bool Voice::isActive() const
+{
+    return active_;
+}
+
+float Voice::getCurrentFrequency() const
+{
+    return currentFrequency_;
+}
+
+uint64_t Voice::getPhase() const
+{
+    return phase_;
+}
+
+uint64_t Voice::getElapsedSamples() const
+{
+    return elapsed_;
+}
+
+void Voice::updateControl()
+{
+    controlCountdown_ = CONTROL_BLOCK - 1;
+
+    double progress = (length_ > 0) ? double(elapsed_) / double(length_) : 0.0;
+    double frequency = frequency_;
+
+    // Glide from the starting frequency towards the target over the note
+    if (automation_.glideToFrequency > 0.0f && frequency_ > 0.0f)
+    {
+        if (automation_.glideCurve == GlideCurve::Linear)
+        {
+            frequency += (automation_.glideToFrequency - frequency_) * progress;
+        }
+        else
+        {
+            frequency *= std::pow(double(automation_.glideToFrequency) / frequency_, progress);
+        }
+    }
+
+    // Pitch offsets in semitones: constant bend plus sinusoidal vibrato
+    double semitones = automation_.pitchBendSemitones;
+    if (automation_.vibratoRateHz > 0.0f)
+    {
+        // The vibrato phase wraps like the oscillator's, so its sin() argument never grows
+        uint64_t vibratoPhase = elapsed_ * vibratoIncrement_;
+        semitones += automation_.vibratoDepthSemitones * std::sin(TWO_PI * (double(vibratoPhase) / PHASE_SCALE));
+    }
+    if (semitones != 0.0)
+    {
+        frequency *= std::pow(2.0, semitones / 12.0);
+    }
+
+    currentFrequency_ = float(frequency);
+
+    // Without glide or vibrato the increment stays put, so the table lookup is skipped
+    uint64_t increment = toPhaseIncrement(frequency / sampleRate_);
+    if (increment != increment_)
+    {
+        increment_ = increment;
+        selectTable();
+    }
+}
+
+void Voice::selectTable()
+{
+    if (waveform_ != Waveform::Buzzer)
+    {
+        table_ = WavetableBank::get().getTable(waveform_, increment_); // Fewer harmonics as the pitch rises
+    }
+}
@@ -0,0 +1,114 @@
+/// @file Wavetable.cpp
+/// @brief Implementation of the WavetableBank class.
+
+#include "tone-synth/Wavetable.h"
+#include <cmath>
+
+static constexpr double PI = 3.141592653589793;
+static constexpr int SHAPE_COUNT = 3;   // Square, triangle and saw (pulse is built from saw)
+static constexpr int SQUARE = 0;
+static constexpr int TRIANGLE = 1;
+static constexpr int SAW = 2;
+
+
+/**
+ * @brief Gets the Fourier coefficient of a harmonic of a shape (of its sine term).
+ */
+static double getHarmonic(int shape, int harmonic)
+{
+    switch (shape)
+    {
+        case SQUARE:
+            return (harmonic % 2 == 1) ? 4.0 / (PI * harmonic) : 0.0;
+        case TRIANGLE:
+            if (harmonic % 2 == 0) return 0.0;
+            return ((harmonic / 2) % 2 == 0 ? 8.0 : -8.0) / (PI * PI * harmonic * harmonic);
+        default:
+            return (harmonic % 2 == 1 ? 2.0 : -2.0) / (PI * harmonic);
+    }
+}
+
+
+const WavetableBank& WavetableBank::get()
+{
+    static const WavetableBank bank; // Built once, on first use
+    return bank;
+}
+
+WavetableBank::WavetableBank()
+    : tables_(size_t(SHAPE_COUNT) * MIP_LEVELS * (TABLE_SIZE + 1), 0.0f)
+{
+    std::vector<double> coefficients(TABLE_SIZE / 2 + 1);
+
+    for (int shape = 0; shape < SHAPE_COUNT; ++shape)
+    {
+        for (int harmonic = 1; harmonic <= TABLE_SIZE / 2; ++harmonic)
+        {
+            coefficients[harmonic] = getHarmonic(shape, harmonic);
+        }
+
+        for (int level = 0; level < MIP_LEVELS; ++level)
+        {
+            const int harmonics = (TABLE_SIZE / 2) >> level;
+            float* out = &tables_[(size_t(shape) * MIP_LEVELS + level) * (TABLE_SIZE + 1)];
+
+            for (int i = 0; i < TABLE_SIZE; ++i)
+            {
+                // Step through sin(hx) by rotation rather than calling sin() for every harmonic
+                const double x = 2.0 * PI * i / TABLE_SIZE;
+                const double sin1 = std::sin(x), cos1 = std::cos(x);
+                double sinH = sin1, cosH = cos1, sum = 0.0;
+
+                for (int harmonic = 1; harmonic <= harmonics; ++harmonic)
+                {
+                    sum += coefficients[harmonic] * sinH;
+                    const double next = (sinH * cos1) + (cosH * sin1);
+                    cosH = (cosH * cos1) - (sinH * sin1);
+                    sinH = next;
+                }
+
+                out[i] = float(sum);
+            }
+
+            out[TABLE_SIZE] = out[0]; // Guard sample for interpolation
+        }
+    }
+}
+
+const float* WavetableBank::getTable(Waveform waveform, uint64_t increment) const
+{
+    const int level = getMipLevel(increment);
+
+    switch (waveform)
+    {
+        case Waveform::Square:   return table(SQUARE, level);
+        case Waveform::Triangle: return table(TRIANGLE, level);
+        case Waveform::Saw:
+        case Waveform::Pulse:    return table(SAW, level);
+        default:                 return nullptr;
+    }
+}
+
+int WavetableBank::getMipLevel(uint64_t increment)
+{
+    // Level k is valid up to 2^k / TABLE_SIZE cycles per sample, i.e. an increment of 2^(k + 64 - TABLE_BITS)
+    const uint64_t octaves = (increment == 0) ? 0 : (increment - 1) >> (64 - TABLE_BITS);
+    int level = 0;
+
+    while (level < MIP_LEVELS - 1 && (uint64_t(1) << level) <= octaves)
+    {
+        ++level;
+    }
+
+    return level;
+}
+
+size_t WavetableBank::getMemoryBytes() const
+{
+    return tables_.size() * sizeof(float);
+}
+
+const float* WavetableBank::table(int shape, int level) const
+{
+    return &tables_[(size_t(shape) * MIP_LEVELS + level) * (TABLE_SIZE + 1)];
+}